@@ -13,6 +13,8 @@
 #include <vector>
 
 #include "../include/MaxSATSolver.hpp"
+#include "../include/GreedyConstruction.hpp"
+#include "../include/WorkStealingPool.hpp"
 
 using namespace std;
 
@@ -33,13 +35,15 @@ class ACOSolver : public MaxSATSolver {
             double q0,
             double tau0,
 
-            uint seed = time(NULL)
+            uint seed = time(NULL),
+            int construction = JOHNSON_CONSTRUCTION
         );
 
         virtual void solve();
         void print_solution();
 
         uint seed;
+        int construction;
         int n_ants;
 
         double alpha;
@@ -58,7 +62,14 @@ class ACOSolver : public MaxSATSolver {
 
         double sum_probs = 0;
 
-        vector<bool> generate_solution();
+        // Threads that run the ants, the scheduler of the ants, and the
+        // assignment built by each ant and its number of satisfied clauses
+        int n_threads = 6;
+        WorkStealingPool pool;
+        vector<vector<bool>> ant_assignment;
+        vector<int> ant_n_satisfied;
+
+        vector<bool> generate_solution(int worker);
         void deposit_pheromones(const vector<bool> &assignment, int n_satisfied);
 };
 
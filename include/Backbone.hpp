@@ -0,0 +1,54 @@
+/**
+ * Backbone estimation from elite assignments and reduction of a Max-SAT
+ * instance to its free variables
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef BACKBONE_H
+#define BACKBONE_H
+
+#define BACKBONE_AGREEMENT 0.9
+
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+
+using namespace std;
+
+/**
+ * @brief Estimates the backbone as the variables that take the same value in
+ * (almost) every elite assignment, fixes them and builds the instance over
+ * the remaining variables: clauses satisfied by a fixed variable are removed
+ * and false literals are dropped from the rest
+ */
+class Backbone {
+  public:
+    Backbone(const SATInstance &instance);
+
+    int estimate(
+        const vector<vector<bool>> &solutions,
+        double agreement = BACKBONE_AGREEMENT
+    );
+    void fix(int var, bool val);
+
+    SATInstance reduce();
+    vector<bool> extend(const vector<bool> &reduced_assignment);
+
+    // Value of each variable: -1 free, 0 false, 1 true
+    vector<int> value;
+    int n_fixed = 0;
+
+    // Clauses of the last reduction that were satisfied or falsified by the
+    // fixed variables, the latter stay unsatisfied whatever the rest is
+    int n_satisfied = 0;
+    int n_falsified = 0;
+
+    // Original variable of each variable of the reduced instance
+    vector<int> free_vars;
+
+  private:
+    SATInstance instance;
+};
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * Implementation of an exact Max-SAT solver based on branch and bound
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef BRANCHANDBOUNDSOLVER_H
+#define BRANCHANDBOUNDSOLVER_H
+
+#define MAX_NODES 100000000
+
+#include <time.h>
+#include <vector>
+
+#include "../include/MaxSATSolver.hpp"
+#include "../include/IncrementalEvaluator.hpp"
+
+/**
+ * @brief An exact MaxSAT solver based on DPLL-style branch and bound, with a
+ * lower bound on the number of unsatisfied clauses computed by counting
+ * disjoint inconsistent subsets detected with unit propagation
+ */
+class BranchAndBoundSolver : public MaxSATSolver {
+  public:
+    using MaxSATSolver::MaxSATSolver;
+    BranchAndBoundSolver(const SATInstance &instance, uint seed = time(NULL));
+
+    virtual void solve();
+    void print_solution();
+
+    uint seed;
+    long long nodes = 0;
+
+    // Normalized clauses and occurrence lists
+    IncrementalEvaluator evaluator;
+
+    // Value of each variable: -1 unassigned, 0 false, 1 true
+    vector<int> value;
+
+    // Number of true and false literals of each clause under the partial
+    // assignment, and number of clauses with every literal false
+    vector<int> n_true;
+    vector<int> n_false;
+    int n_falsified = 0;
+
+    // Assigned variables in order, to undo the assignments
+    vector<int> trail;
+
+    // Number of clauses that the best assignment found leaves unsatisfied
+    int best_n_falsified;
+
+    void branch();
+    bool simplify();
+    int choose_var(bool &preferred_value);
+    int count_inconsistent_subsets();
+    int propagate(int from);
+    int free_literal(int clause);
+
+    void assign(int var, bool val);
+    void undo(int trail_size);
+    void save_solution();
+
+  private:
+    // Scratch space of the rules, the branching heuristic and the bound
+    vector<int> n_occurrences;
+    vector<int> n_units;
+    vector<double> jw_score;
+    vector<int> reason;
+    vector<int> used;
+    int stamp = 0;
+};
+
+#endif
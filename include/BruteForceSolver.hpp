@@ -7,20 +7,35 @@
 #ifndef BRUTEFORCESOLVER_H
 #define BRUTEFORCESOLVER_H
 
+// Number of variables whose values split the search space in 2^PREFIX_BITS
+// parts, enumerated in parallel
+#define PREFIX_BITS 8
+
+#include <cstdint>
+#include <vector>
+
 #include "../include/MaxSATSolver.hpp"
 
 /**
- * @brief A MaxSAT solver
+ * @brief A MaxSAT solver that enumerates every assignment. The last variables
+ * are fixed by a prefix, one per parallel task, and the rest are enumerated in
+ * Gray code order, so each step flips a single variable and only updates the
+ * clauses it appears in
  */
 class BruteForceSolver : public MaxSATSolver {
   public:
     using MaxSATSolver::MaxSATSolver;
-    BruteForceSolver(const SATInstance &instance);
+    BruteForceSolver(const SATInstance &instance, int n_threads = 6);
 
     virtual void solve();
     void print_solution();
 
-    void solve_helper(vector<bool> &assignment, int i);
+    int n_threads;
+
+    // Maps a literal to the clauses it appears in
+    vector<vector<int>> occurrences;
+
+    void enumerate(uint64_t prefix, int n_free);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,91 @@
+/**
+ * A small conflict-driven clause learning (CDCL) SAT engine with incremental
+ * assumptions
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef CDCLENGINE_H
+#define CDCLENGINE_H
+
+#include <vector>
+
+using namespace std;
+
+#define SAT_RESULT 1
+#define UNSAT_RESULT 0
+#define UNKNOWN_RESULT -1
+
+/**
+ * @brief A CDCL SAT engine with two watched literals, first UIP learning,
+ * VSIDS decisions, Luby restarts and solving under assumptions. Literals use
+ * the same mapping as SATInstance: x -> 2x, -x -> 2x+1
+ */
+class CDCLEngine {
+  public:
+    CDCLEngine();
+
+    int new_var();
+    bool add_clause(vector<int> literals);
+    int solve(const vector<int> &assumptions, long long max_conflicts = -1);
+
+    int n_vars = 0;
+    long long conflicts = 0;
+
+    // Model of the last satisfiable call
+    vector<bool> model;
+
+    // Assumptions of the last unsatisfiable call that imply the conflict
+    vector<int> core;
+
+  private:
+    // False while the clauses added at level 0 are consistent
+    bool ok = true;
+
+    vector<vector<int>> clauses;
+    vector<bool> learnt;
+    vector<bool> deleted;
+    vector<int> lbd;
+    int n_learnts = 0;
+    int max_learnts = 2000;
+
+    // Clauses watching each literal
+    vector<vector<int>> watches;
+
+    // Value of each variable: -1 unassigned, 0 false, 1 true
+    vector<signed char> assigns;
+    vector<int> level;
+    vector<int> reason;
+    vector<bool> polarity;
+
+    vector<int> trail;
+    vector<int> trail_lim;
+    uint qhead = 0;
+
+    // VSIDS activities and a binary heap of the variables ordered by them
+    vector<double> activity;
+    double var_inc = 1;
+    vector<int> heap;
+    vector<int> heap_index;
+
+    vector<bool> seen;
+
+    int value(int literal);
+    int decision_level();
+    void enqueue(int literal, int from);
+    int propagate();
+    void analyze(int conflict, vector<int> &out_learnt, int &out_level);
+    void analyze_final(int literal);
+    void cancel_until(int lvl);
+    int attach(vector<int> &literals, bool is_learnt);
+    void reduce_db();
+    bool locked(int clause);
+
+    void bump(int var);
+    void heap_insert(int var);
+    int heap_pop();
+    void heap_up(int i);
+    void heap_down(int i);
+};
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * Clause-based crossover with greedy repair for Max-SAT
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef CLAUSECROSSOVER_H
+#define CLAUSECROSSOVER_H
+
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/IncrementalEvaluator.hpp"
+
+using namespace std;
+
+/**
+ * @brief Builds a child from two parents clause by clause instead of variable
+ * by variable. The variables of each clause satisfied by only one parent are
+ * taken from that parent, and each clause satisfied by both is satisfied with
+ * the literals of one of them. The clauses that the child breaks although a
+ * parent satisfies them are then repaired greedily, flipping the variable of
+ * the clause with the best gain
+ */
+class ClauseCrossover {
+  public:
+    ClauseCrossover(const SATInstance &instance);
+
+    int cross(
+        const vector<bool> &parent1,
+        const vector<bool> &parent2,
+        int start,
+        vector<bool> &child
+    );
+
+    // Number of children built and of flips made by the repair
+    long long n_children = 0;
+    long long n_repairs = 0;
+
+    IncrementalEvaluator evaluator;
+
+  private:
+    bool satisfies(int clause, const vector<bool> &assignment);
+    void assign(int clause, const vector<bool> &parent);
+    void repair(const vector<bool> &parent1, const vector<bool> &parent2);
+
+    // Value of each variable of the child, -1 while it is not assigned
+    vector<signed char> value;
+
+    // Clauses left unsatisfied by the crossover
+    vector<int> broken;
+};
+
+#endif
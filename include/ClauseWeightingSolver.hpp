@@ -0,0 +1,55 @@
+/**
+ * Implementation of a Max-SAT solver based on dynamic clause weighting
+ * (SATLike-style)
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef CLAUSEWEIGHTINGSOLVER_H
+#define CLAUSEWEIGHTINGSOLVER_H
+
+#define MAX_FLIPS 1000000
+
+#include <time.h>
+#include <vector>
+
+#include "../include/MaxSATSolver.hpp"
+#include "../include/IncrementalEvaluator.hpp"
+
+/**
+ * @brief A MaxSAT solver based on local search with dynamic clause weights
+ */
+class ClauseWeightingSolver : public MaxSATSolver {
+  public:
+    using MaxSATSolver::MaxSATSolver;
+
+    ClauseWeightingSolver(
+        const SATInstance &instance,
+        int bms_samples,
+        double smooth_probability,
+        int max_weight,
+        uint seed = time(NULL)
+    );
+
+    virtual void solve();
+    void print_solution();
+
+    uint seed;
+    int flips = 0;
+    int max_flips = MAX_FLIPS;
+    int bms_samples;
+    double smooth_probability;
+    int max_weight;
+
+    IncrementalEvaluator evaluator;
+
+    // Last step in which each variable was flipped, used to break ties
+    vector<int> last_flip;
+
+    int pick_bms_var();
+    int pick_clause_var(int clause);
+    void update_weights();
+    void flip(int var);
+};
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * Implementation of an exact Max-SAT solver guided by unsatisfiable cores
+ * (OLL)
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef COREGUIDEDSOLVER_H
+#define COREGUIDEDSOLVER_H
+
+#define MAX_CONFLICTS 10000000
+#define MINIMIZE_CONFLICTS 1000
+
+#include <vector>
+
+#include "../include/MaxSATSolver.hpp"
+#include "../include/CDCLEngine.hpp"
+
+/**
+ * @brief An exact MaxSAT solver that relaxes the unsatisfiable cores found by
+ * an embedded CDCL engine with cardinality constraints until the formula is
+ * satisfiable under the remaining assumptions
+ */
+class CoreGuidedSolver : public MaxSATSolver {
+  public:
+    using MaxSATSolver::MaxSATSolver;
+    CoreGuidedSolver(const SATInstance &instance);
+
+    virtual void solve();
+    void print_solution();
+
+    int n_cores = 0;
+    int lower_bound = 0;
+
+    CDCLEngine engine;
+
+    // Literals assumed true in the next call: negated selectors of the soft
+    // clauses and negated outputs of the totalizers
+    vector<int> assumptions;
+
+    // Outputs of each totalizer: output k is true if more than k inputs are
+    vector<vector<int>> totalizers;
+
+    // For each engine variable, the totalizer it is an output of (or -1) and
+    // its position among the outputs
+    vector<int> totalizer_of;
+    vector<int> output_index;
+
+    void minimize_core(vector<int> &core);
+    void relax(const vector<int> &core);
+    vector<int> build_totalizer(const vector<int> &inputs, int from, int to);
+};
+
+#endif
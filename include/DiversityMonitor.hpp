@@ -0,0 +1,70 @@
+/**
+ * Diversity of the population of an evolutionary algorithm
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef DIVERSITYMONITOR_H
+#define DIVERSITYMONITOR_H
+
+// The population has collapsed when two individuals differ, on average, in
+// less than this fraction of the variables, on top of what the mutation of
+// both accounts for
+#define DIVERSITY_THRESHOLD 0.005
+
+// Response of the solver when the population collapses
+#define NO_RESPONSE 0
+#define RESEED_RESPONSE 1
+#define MUTATION_BOOST_RESPONSE 2
+#define STOP_RESPONSE 3
+
+// Fraction of the population replaced by new individuals when reseeding
+#define RESEED_FRACTION 0.5
+
+// After reseeding or boosting the mutation, the solver waits RESPONSE_INTERVAL
+// generations before responding again, and the mutation percent is multiplied
+// by MUTATION_BOOST during that time
+#define RESPONSE_INTERVAL 10
+#define MUTATION_BOOST 5
+
+// The search stops after STOP_GENERATIONS consecutive collapsed generations
+#define STOP_GENERATIONS 50
+
+// Number of values of the trace that are printed
+#define TRACE_POINTS 20
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Measures the mean Hamming distance between two individuals of the
+ * population, as a fraction of the number of variables, and keeps its trace.
+ * If c individuals out of n take the value true for a variable, c (n - c) of
+ * the n (n - 1) / 2 pairs differ on it, so the exact mean over all the pairs
+ * is found in a single pass over the population
+ */
+class DiversityMonitor {
+  public:
+    DiversityMonitor(int n_vars, double threshold = DIVERSITY_THRESHOLD);
+
+    double measure(const vector<vector<bool>> &population);
+    bool collapsed();
+    void print_trace();
+
+    int n_vars;
+    double threshold;
+    int n_collapses = 0;
+
+    // Number of consecutive collapsed generations up to the last one
+    int streak = 0;
+
+    // Diversity of every generation
+    vector<double> trace;
+
+  private:
+    // Number of individuals that take the value true for each variable
+    vector<int> n_true;
+};
+
+#endif
@@ -0,0 +1,48 @@
+/**
+ * Bounded archive of good and diverse assignments for a Max-SAT instance
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef ELITEARCHIVE_H
+#define ELITEARCHIVE_H
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Keeps at most capacity assignments. An assignment closer than
+ * min_distance (in Hamming distance) to a member can only replace that member,
+ * and only if it is better; otherwise it replaces the worst member when the
+ * archive is full. Assignments are also stored packed in 64-bit words, so a
+ * distance is a popcount of their xor
+ */
+class EliteArchive {
+  public:
+    EliteArchive(int n_vars, int capacity, int min_distance);
+
+    bool add(const vector<bool> &assignment, int n_satisfied);
+    int distance(int i, int j);
+    int best();
+    int size();
+
+    static void pack(const vector<bool> &assignment, vector<uint64_t> &words);
+
+    int n_vars;
+    int capacity;
+    int min_distance;
+
+    vector<vector<bool>> solutions;
+    vector<vector<uint64_t>> packed;
+    vector<int> fitness;
+
+  private:
+    // Packed assignment being offered
+    vector<uint64_t> words;
+
+    int distance(const vector<uint64_t> &a, const vector<uint64_t> &b);
+};
+
+#endif
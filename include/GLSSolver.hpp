@@ -7,12 +7,14 @@
 #ifndef GLSSOLVER_H
 #define GLSSOLVER_H
 
-#define MAX_TRIALS 100
+#define MAX_TRIALS 100000
 
 #include <time.h>
-#include <queue>
+#include <vector>
 
 #include "../include/MaxSATSolver.hpp"
+#include "../include/IncrementalEvaluator.hpp"
+#include "../include/GreedyConstruction.hpp"
 
 /**
  * @brief A MaxSAT solver based on local search metaheuristic
@@ -20,23 +22,30 @@
 class GLSSolver : public MaxSATSolver {
   public:
     using MaxSATSolver::MaxSATSolver;
-    GLSSolver(const SATInstance &instance, uint seed = time(NULL));
+    GLSSolver(
+        const SATInstance &instance,
+        uint seed = time(NULL),
+        int construction = JOHNSON_CONSTRUCTION
+    );
 
     virtual void solve();
     void print_solution();
 
     uint seed;
+    int construction;
     int trials = 0;
-    double param = 1;
+    int param = 1;
 
-    // Penality for each variable
+    // Penality for each clause
     vector<int> penalty;
 
-    priority_queue<pair<double, int>> utility;
+    // Keeps the augmented objective: the weight of each clause is
+    // 1 + param * penalty, so the score of a variable is its change in
+    // satisfied clauses minus its change in penalties
+    IncrementalEvaluator evaluator;
 
-    pair<int, int> evaluate_guided_flip(vector<bool> &assignment, int flipped_var, int current_n_satisfied);
-    int penalty_sum(vector<bool> &assignment);
-    bool indicator(vector<bool> &assignment, int i);
+    void descend();
+    void penalize();
 };
 
 #endif
\ No newline at end of file
@@ -9,10 +9,47 @@
 
 #define MAX_GENS 1000
 
+// Generational: each generation replaces the population except the elite.
+// Steady state: each child replaces an individual in place if it is better
+#define GENERATIONAL_SCHEME 0
+#define STEADY_STATE_SCHEME 1
+
+// Individual replaced by a child in the steady state scheme
+#define WORST_REPLACEMENT 0
+#define TOURNAMENT_REPLACEMENT 1
+
+// Operators chosen by the operator selectors, the first one of each kind is
+// the one used with FIXED_OPERATORS
+#define TOURNAMENT_SELECTION 0
+#define ROULETTE_WHEEL_SELECTION 1
+#define ELITIST_SELECTION 2
+#define TWO_POINT_CROSSOVER 0
+#define ONE_POINT_CROSSOVER 1
+#define RANDOM_MUTATION 0
+#define GREEDY_MUTATION 1
+
+// Fitness of an individual: its number of satisfied clauses, or the total
+// weight of the clauses it satisfies, where the clauses left unsatisfied by
+// the best individual gain SAW_INCREMENT weight every saw_interval generations
+// (stepwise adaptation of weights)
+#define SATISFIED_FITNESS 0
+#define SAW_FITNESS 1
+#define SAW_INTERVAL 5
+#define SAW_INCREMENT 1
+
+// Distance between the random generators of two threads, a cache line
+#define RANDOM_STRIDE 8
+
+#include <cstdint>
 #include <time.h>
 #include <vector>
 
 #include "../include/MaxSATSolver.hpp"
+#include "../include/GreedyConstruction.hpp"
+#include "../include/EliteArchive.hpp"
+#include "../include/PathRelinkingSolver.hpp"
+#include "../include/OperatorSelector.hpp"
+#include "../include/DiversityMonitor.hpp"
 
 /**
  * @brief A MaxSAT solver based on genetic algorithm
@@ -28,14 +65,18 @@ class GeneticAlgorithmSolver : public MaxSATSolver {
             int mutation_probability,
             int mutation_percent,
             int elite_percent,
-            uint seed = time(NULL)
+            uint seed = time(NULL),
+            int construction = JOHNSON_CONSTRUCTION
         );
 
         virtual void solve();
+        void evolve();
+        void evolve_steady_state(int n_offspring);
 
         void print_solution();
 
         uint seed;
+        int construction;
         uint population_size;
         int generation = 0;
         int tournament_size;
@@ -43,27 +84,108 @@ class GeneticAlgorithmSolver : public MaxSATSolver {
         int mutation_percent;
         int elite_percent;
 
+        int scheme = GENERATIONAL_SCHEME;
+
+        // Diversity of each generation and response when it collapses; the
+        // mutation percent is multiplied by mutation_boost, no response is
+        // given for cooldown more generations, and stagnated stops the search
+        DiversityMonitor diversity;
+        int diversity_response = NO_RESPONSE;
+        int mutation_boost = 1;
+        int cooldown = 0;
+        bool stagnated = false;
+        void monitor_diversity();
+        void reseed();
+
+        int fitness_mode = SATISFIED_FITNESS;
+        int saw_interval = SAW_INTERVAL;
+        int replacement = WORST_REPLACEMENT;
+
+        // Operators of each kind are fixed or chosen by a bandit that
+        // rewards the improvement they produce per second
+        int operator_policy = FIXED_OPERATORS;
+        OperatorSelector selection_operators;
+        OperatorSelector crossover_operators;
+        OperatorSelector mutation_operators;
+        double mean_fitness;
+
+        void breed(
+            vector<bool> &child1,
+            int &child1_fitness,
+            vector<bool> &child2,
+            int &child2_fitness
+        );
+        void update_operators();
+
+        // Threads that build each generation of the generational scheme
+        int n_threads = 6;
+
+        // Current and next population, swapped after each generation, a
+        // buffer for a discarded child and the order used to pick the elite
         vector<vector<bool>> population;
         vector<int> fitness;
+        vector<vector<bool>> next_population;
+        vector<int> next_fitness;
+        vector<bool> spare;
+        vector<int> elite_order;
+
+        // Weight of each clause in the fitness, all 1 unless adapted, and the
+        // clauses adapted last
+        vector<int> clause_weight;
+        vector<int> adapted_clauses;
+        void save_best();
+        void adapt_weights();
+        int evaluate(const vector<bool> &assignment);
+
+        // Steady state scheme: individuals grouped by fitness, bucket i
+        // holding the ones that satisfy i clauses, the position of each one in
+        // its bucket, and the buffers of the two children
+        vector<vector<int>> buckets;
+        vector<int> bucket_index;
+        int bottom_bucket;
+        vector<vector<bool>> children;
+
+        void index_population();
+        void set_fitness(int i, int value);
+        int worst_individual();
+        bool is_duplicate(const vector<bool> &solution, int n_satisfied);
+
+        // Good and diverse individuals, relinked every relink_interval
+        // generations (0 disables it)
+        EliteArchive archive;
+        int relink_interval = 0;
+        void intensify(PathRelinkingSolver &relinker);
 
         // Crossover
         void cross(
-            const vector<bool> &parent1,
-            const vector<bool> &parent2,
+            int parent1,
+            int parent2,
             vector<bool> &child1,
-            vector<bool> &child2
+            int &child1_fitness,
+            vector<bool> &child2,
+            int &child2_fitness
         );
 
         void two_point_crossover(
-            const vector<bool> &parent1,
-            const vector<bool> &parent2,
+            int parent1,
+            int parent2,
             vector<bool> &child1,
-            vector<bool> &child2
+            int &child1_fitness,
+            vector<bool> &child2,
+            int &child2_fitness
+        );
+
+        int recombine(
+            int inner,
+            int outer,
+            int begin,
+            int end,
+            vector<bool> &child
         );
 
         // Mutation
-        int mutate(vector<bool> &solution);
-        int mutateGreedy(vector<bool> &solution);
+        int mutate(vector<bool> &solution, int n_satisfied);
+        int mutateGreedy(vector<bool> &solution, int n_satisfied);
         int eval_function(
             vector<bool> &assignment,
             int flipped_var,
@@ -71,15 +193,21 @@ class GeneticAlgorithmSolver : public MaxSATSolver {
         );
 
         // Selection
-        vector<bool> tournament_selection();
-        vector<bool> roulette_wheel_selection();
-        vector<bool> elitist_selection();
-
-        void select_elite(
-            vector<vector<bool>> &population,
-            vector<int> &fitness,
-            int n_elite
-        );
+        int tournament_selection();
+        int roulette_wheel_selection();
+        int elitist_selection();
+        int tournament_loser();
+        int select_parent(int op);
+
+        void select_elite(int n_elite);
+
+    private:
+        // State of the random generator of each thread, and nesting level of
+        // the parallel region of evolve()
+        vector<uint64_t> random_state;
+        int team_level = 1;
+        void seed_generators(int n);
+        uint32_t next_random();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,62 @@
+/**
+ * Greedy construction of initial assignments for a Max-SAT instance
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef GREEDYCONSTRUCTION_H
+#define GREEDYCONSTRUCTION_H
+
+#define RANDOM_CONSTRUCTION 0
+#define JOHNSON_CONSTRUCTION 1
+#define PROPAGATION_CONSTRUCTION 2
+
+#include <cstdint>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+
+using namespace std;
+
+/**
+ * @brief Builds assignments one variable at a time in O(total literals).
+ * Johnson's method gives each variable the value with the largest conditional
+ * expectation of satisfied clauses, assuming the unassigned variables are
+ * random; the propagation method first satisfies the clauses left with a
+ * single unassigned literal and uses Johnson's rule for the rest. The random
+ * choices draw from rand() unless the construction is given its own generator
+ * with reseed(), e.g. when it runs in a thread of its own
+ */
+class GreedyConstruction {
+  public:
+    GreedyConstruction(const SATInstance &instance);
+
+    vector<bool> construct(int method, bool shuffle = true);
+    void reseed(uint64_t seed);
+
+    int n_vars;
+    int n_clauses;
+
+  private:
+    vector<vector<int>> clauses;
+
+    // Maps a variable to the (clause, literal) pairs it appears in
+    vector<vector<pair<int, int>>> occurrences;
+
+    // State of the construction: value of each variable (-1 unassigned),
+    // unassigned literals of each clause, satisfied clauses and clauses with
+    // a single unassigned literal
+    vector<int> value;
+    vector<int> n_free;
+    vector<bool> satisfied;
+    vector<int> units;
+
+    bool choose_value(int var, bool shuffle);
+    void assign(int var, bool val, bool propagate);
+
+    // State of the xorshift64* generator, 0 while the construction uses rand()
+    uint64_t random_state = 0;
+    uint32_t next_random();
+};
+
+#endif
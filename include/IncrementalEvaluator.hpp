@@ -0,0 +1,77 @@
+/**
+ * Incremental evaluation of single variable flips for a Max-SAT instance
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef INCREMENTALEVALUATOR_H
+#define INCREMENTALEVALUATOR_H
+
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+
+using namespace std;
+
+/**
+ * @brief Keeps, for a current assignment, the number of true literals of each
+ * clause, the list of unsatisfied clauses and the weighted score (make - break)
+ * of every variable, so that a flip only touches the clauses of the flipped
+ * variable
+ */
+class IncrementalEvaluator {
+  public:
+    IncrementalEvaluator(const SATInstance &instance);
+
+    void reset(const vector<bool> &assignment);
+    void flip(int var);
+    void add_weight(int clause, int amount);
+    void reset_weights();
+
+    // Change in the number of satisfied clauses if var is flipped
+    int delta(int var);
+
+    int n_vars;
+    int n_clauses;
+
+    // Clauses without repeated literals, tautologies are left empty
+    vector<vector<int>> clauses;
+    vector<bool> tautology;
+
+    // Maps a variable to the (clause, literal) pairs it appears in
+    vector<vector<pair<int, int>>> occurrences;
+
+    vector<bool> assignment;
+    int n_satisfied;
+
+    // Number of true literals and the xor of their variables, which is the
+    // only true variable when there is just one
+    vector<int> n_true;
+    vector<int> sat_var;
+
+    // Unsatisfied clauses and the position of each one in the list (or -1)
+    vector<int> unsat_clauses;
+    vector<int> unsat_index;
+
+    // Clause weights and weighted make - break of each variable
+    vector<int> weight;
+    vector<int> score;
+
+    // Variables whose score changed since the last clear_touched()
+    vector<int> touched;
+    vector<char> is_touched;
+    void clear_touched();
+
+    // Variables with positive score and the position of each one (or -1),
+    // brought up to date with the touched variables by update_good_vars()
+    vector<int> good_vars;
+    vector<int> good_index;
+    void update_good_vars();
+
+  private:
+    void change_score(int var, int amount);
+    void make_unsat(int clause);
+    void make_sat(int clause);
+};
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * Implementation of a Max-SAT solver based on an island model of genetic
+ * algorithms
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef ISLANDMODELSOLVER_H
+#define ISLANDMODELSOLVER_H
+
+#define MIGRATION_INTERVAL 10
+#define N_MIGRANTS 2
+#define MAILBOX_SIZE 4
+
+#define RING_TOPOLOGY 0
+#define RANDOM_TOPOLOGY 1
+
+// States of a slot of a mailbox
+#define SLOT_EMPTY 0
+#define SLOT_WRITING 1
+#define SLOT_FULL 2
+
+#include <atomic>
+#include <time.h>
+#include <vector>
+
+#include "../include/MaxSATSolver.hpp"
+#include "../include/GeneticAlgorithmSolver.hpp"
+#include "../include/GreedyConstruction.hpp"
+
+/**
+ * @brief A MaxSAT solver that runs one genetic algorithm per thread, each on
+ * its own subpopulation and with its own random generator. Every
+ * migration_interval generations an island sends copies of its best
+ * individuals to the mailbox of its successor in a ring or of a random island,
+ * and the migrants it has received replace its worst individuals. Mailboxes
+ * are fixed slots claimed with a compare and swap, so the islands never wait
+ * for each other; only an improvement of the shared incumbent takes a lock
+ */
+class IslandModelSolver : public MaxSATSolver {
+  public:
+    using MaxSATSolver::MaxSATSolver;
+
+    IslandModelSolver(
+        const SATInstance &instance,
+        int n_islands,
+        int population_size,
+        int tournament_size,
+        int mutation_probability,
+        int mutation_percent,
+        int elite_percent,
+        uint seed = time(NULL),
+        int construction = JOHNSON_CONSTRUCTION
+    );
+
+    virtual void solve();
+    void print_solution();
+
+    uint seed;
+    int n_islands;
+    int topology = RING_TOPOLOGY;
+    int migration_interval = MIGRATION_INTERVAL;
+    int n_migrants = N_MIGRANTS;
+
+    vector<GeneticAlgorithmSolver> islands;
+
+    // Migrants sent and accepted by each island
+    vector<int> n_sent;
+    vector<int> n_accepted;
+
+  private:
+    // Slot j of the mailbox of island i is i * MAILBOX_SIZE + j
+    vector<atomic<int>> slot_state;
+    vector<vector<bool>> slot_migrant;
+    vector<int> slot_fitness;
+
+    // Number of satisfied clauses of the incumbent, read without the lock
+    atomic<int> incumbent;
+    atomic<bool> stop;
+
+    void evolve(int island);
+    void emigrate(int island, int target);
+    void immigrate(int island);
+    void share(int island);
+};
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * Budgeted local improvement of an assignment for Max-SAT
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef LOCALIMPROVER_H
+#define LOCALIMPROVER_H
+
+// Improvement methods
+#define FIRST_IMPROVEMENT 0
+#define BEST_IMPROVEMENT 1
+#define ANNEALING_IMPROVEMENT 2
+#define TABU_IMPROVEMENT 3
+#define WALKSAT_IMPROVEMENT 4
+
+// Initial temperature of the annealing, which cools linearly to 0 over the
+// budget, tabu tenure and probability of a random walk move in WalkSAT
+#define IMPROVER_TEMPERATURE 2.0
+#define IMPROVER_TENURE 10
+#define WALKSAT_NOISE 0.5
+
+#include <cstdint>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/IncrementalEvaluator.hpp"
+
+using namespace std;
+
+/**
+ * @brief Improves an assignment with one of several local searches, for at
+ * most a given number of steps (flips, or proposals for the annealing). The
+ * descents stop earlier at a local optimum; the other methods keep moving
+ * until the budget runs out and return the best assignment they visited,
+ * undoing the flips made after it
+ */
+class LocalImprover {
+  public:
+    LocalImprover(
+        const SATInstance &instance,
+        int method = FIRST_IMPROVEMENT,
+        uint64_t seed = 1
+    );
+
+    int improve(vector<bool> &assignment, int budget);
+    void reseed(uint64_t seed);
+
+    int method;
+    double temperature = IMPROVER_TEMPERATURE;
+    int tenure = IMPROVER_TENURE;
+    double noise = WALKSAT_NOISE;
+
+    // Number of satisfied clauses at which the search stops
+    int upper_bound;
+
+    // Number of assignments improved and of steps taken
+    long long n_calls = 0;
+    long long n_steps = 0;
+
+    IncrementalEvaluator evaluator;
+
+  private:
+    int first_improvement(int budget);
+    int best_improvement(int budget);
+    int anneal(int budget);
+    int tabu(int budget);
+    int walk(int budget);
+
+    void flip(int var);
+    int break_count(int var);
+    bool done();
+
+    // Best number of satisfied clauses and the flips made since it was found
+    int best_n_satisfied;
+    vector<int> flip_log;
+
+    // Step from which each variable is no longer tabu, on a clock that only
+    // advances during the tabu search
+    vector<long long> tabu_until;
+    long long tabu_clock = 0;
+
+    uint64_t random_state;
+    uint32_t next_random();
+};
+
+#endif
@@ -10,6 +10,7 @@
 #include <time.h>
 
 #include "../include/MaxSATSolver.hpp"
+#include "../include/GreedyConstruction.hpp"
 
 /**
  * @brief A MaxSAT solver based on local search metaheuristic
@@ -17,7 +18,11 @@
 class LocalSearchSolver : public MaxSATSolver {
   public:
     using MaxSATSolver::MaxSATSolver;
-    LocalSearchSolver(const SATInstance &instance, uint seed = time(NULL));
+    LocalSearchSolver(
+        const SATInstance &instance,
+        uint seed = time(NULL),
+        int construction = JOHNSON_CONSTRUCTION
+    );
 
     virtual void solve();
 
@@ -26,6 +31,7 @@ class LocalSearchSolver : public MaxSATSolver {
     void print_solution();
 
     uint seed;
+    int construction;
 };
 
 #endif
\ No newline at end of file
@@ -27,12 +27,21 @@ class MaxSATSolver {
 
     int compute_n_satisfied(const vector<bool> &assignment);
 
+    void set_initial_assignment(const vector<bool> &assignment);
+    void compute_upper_bound();
+    void set_upper_bound(int bound);
+
     SATInstance instance;
 
     int optimal_n_satisfied;
     bool optimal_found;
     vector<bool> optimal_assignment;
 
+    // Maximum number of clauses that can be satisfied, the optimum is found
+    // once optimal_n_satisfied reaches it
+    int upper_bound;
+    bool upper_bound_computed;
+
     // Maps a variable to the clauses it appears in
     vector<vector<int>> affected_clauses;
 };
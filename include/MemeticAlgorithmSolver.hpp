@@ -9,10 +9,31 @@
 
 #define MAX_GENERATIONS 100
 
+// Recombinations chosen by the operator selector. Clause recombination builds
+// the child from the clauses satisfied by its parents, see ClauseCrossover
+#define UNIFORM_RECOMBINATION 0
+#define SEGMENT_RECOMBINATION 1
+#define CLAUSE_RECOMBINATION 2
+
+// Steps of local improvement of each child: always FLIP_BUDGET, or scaled by
+// how good the child is, from MIN_BUDGET_FRACTION to twice FLIP_BUDGET
+#define FLIP_BUDGET 1000
+#define FIXED_BUDGET 0
+#define QUALITY_BUDGET 1
+#define MIN_BUDGET_FRACTION 0.25
+
 #include <time.h>
 #include <vector>
 
 #include "../include/MaxSATSolver.hpp"
+#include "../include/GreedyConstruction.hpp"
+#include "../include/EliteArchive.hpp"
+#include "../include/PathRelinkingSolver.hpp"
+#include "../include/OperatorSelector.hpp"
+#include "../include/DiversityMonitor.hpp"
+#include "../include/ClauseCrossover.hpp"
+#include "../include/LocalImprover.hpp"
+#include "../include/WorkStealingPool.hpp"
 
 /**
  * @brief A MaxSAT solver based on memetic algorithm
@@ -28,7 +49,8 @@ class MemeticAlgorithmSolver : public MaxSATSolver {
             int mutation_probability,
             int mutation_percent,
             int elite_percent,
-            uint seed = time(NULL)
+            uint seed = time(NULL),
+            int construction = JOHNSON_CONSTRUCTION
         );
 
         virtual void solve();
@@ -36,6 +58,7 @@ class MemeticAlgorithmSolver : public MaxSATSolver {
         void print_solution();
 
         uint seed;
+        int construction;
         uint population_size;
         int generation = 0;
         int tournament_size;
@@ -46,14 +69,79 @@ class MemeticAlgorithmSolver : public MaxSATSolver {
         vector<vector<bool>> population;
         vector<int> fitness;
 
+        // Diversity of each generation and response when it collapses; the
+        // mutation percent is multiplied by mutation_boost, no response is
+        // given for cooldown more generations, and stagnated stops the search
+        DiversityMonitor diversity;
+        int diversity_response = NO_RESPONSE;
+        int mutation_boost = 1;
+        int cooldown = 0;
+        bool stagnated = false;
+        void monitor_diversity();
+        void reseed();
+
+        // Local improvement of every individual with the improver method, see
+        // LocalImprover. With QUALITY_BUDGET the budget of a child depends on
+        // where its fitness falls between the worst and the best child of the
+        // previous generation before improvement
+        int improver = FIRST_IMPROVEMENT;
+        int flip_budget = FLIP_BUDGET;
+        int budget_mode = FIXED_BUDGET;
+        int worst_child = 0;
+        int best_child = 0;
+        vector<LocalImprover> improvers;
+        int child_budget(int child_fitness);
+
+        // Good and diverse individuals, relinked every relink_interval
+        // generations (0 disables it)
+        EliteArchive archive;
+        int relink_interval = 0;
+        void intensify(PathRelinkingSolver &relinker);
+
+        // Recombination is fixed (recombination) or chosen by a bandit that
+        // rewards the improvement of the children per second
+        int operator_policy = FIXED_OPERATORS;
+        int recombination = UNIFORM_RECOMBINATION;
+        OperatorSelector recombination_operators;
+
+        // Threads that build each generation, the scheduler of their tasks,
+        // and the clause crossover of each one (each one also has its own
+        // improver)
+        int n_threads = 6;
+        WorkStealingPool pool;
+        vector<ClauseCrossover> clause_crossovers;
+
         // Crossover
         void uniform_recombination(
-            vector<vector<bool>> &parents,
-            vector<vector<bool>> &children
+            const vector<int> &parents,
+            vector<vector<bool>> &children,
+            vector<int> &children_fitness,
+            int worker
+        );
+
+        void segment_recombination(
+            const vector<int> &parents,
+            vector<vector<bool>> &children,
+            vector<int> &children_fitness,
+            int worker
+        );
+
+        void clause_recombination(
+            const vector<int> &parents,
+            vector<vector<bool>> &children,
+            vector<int> &children_fitness,
+            int worker
+        );
+
+        void score_child(
+            const vector<int> &parents,
+            const vector<bool> &values,
+            vector<bool> &child,
+            int &child_fitness
         );
 
         // Mutation
-        int mutate(vector<bool> &solution);
+        int mutate(vector<bool> &solution, int n_satisfied, int worker);
         int eval_function(
             vector<bool> &assignment,
             int flipped_var,
@@ -61,7 +149,7 @@ class MemeticAlgorithmSolver : public MaxSATSolver {
         );
 
         // Selection
-        vector<bool> tournament_selection();
+        int tournament_selection(int worker);
 
         void select_elite(
             vector<vector<bool>> &population,
@@ -0,0 +1,62 @@
+/**
+ * Implementation of a multilevel Max-SAT solver
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef MULTILEVELSOLVER_H
+#define MULTILEVELSOLVER_H
+
+#define MAX_LEVELS 40
+#define MIN_SHARED_CLAUSES 2
+
+#include <time.h>
+#include <vector>
+
+#include "../include/MaxSATSolver.hpp"
+
+/**
+ * @brief A MaxSAT solver that coarsens the formula by merging strongly
+ * co-occurring variables, solves the coarsest formula and projects the
+ * assignment back, refining it with clause weighting local search on every
+ * level
+ */
+class MultilevelSolver : public MaxSATSolver {
+  public:
+    using MaxSATSolver::MaxSATSolver;
+
+    MultilevelSolver(
+        const SATInstance &instance,
+        int coarsest_vars,
+        int flips_per_var,
+        uint seed = time(NULL)
+    );
+
+    virtual void solve();
+    void print_solution();
+
+    uint seed;
+    int coarsest_vars;
+    int flips_per_var;
+
+    // Formula of each level, the first one is the instance itself
+    vector<SATInstance> levels;
+
+    // For each level but the last, maps each variable to the literal of the
+    // next level that gives its value
+    vector<vector<int>> projections;
+
+    // Clauses dropped as tautologies up to each level
+    vector<int> n_dropped;
+
+    void coarsen();
+    SATInstance merge_vars(
+        const SATInstance &fine,
+        vector<int> &projection,
+        int &n_tautologies
+    );
+    vector<bool> project(const vector<bool> &coarse, const vector<int> &projection);
+    void refine(int level, vector<bool> &assignment);
+};
+
+#endif
@@ -0,0 +1,66 @@
+/**
+ * Adaptive selection of the operators of an evolutionary algorithm
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef OPERATORSELECTOR_H
+#define OPERATORSELECTOR_H
+
+// The first operator is always used
+#define FIXED_OPERATORS 0
+#define ADAPTIVE_PURSUIT 1
+#define UCB_SELECTION 2
+
+// Adaptive pursuit: weight of the last reward in the quality, speed at which
+// the probabilities move towards the best operator, and minimum probability
+// of every operator as a fraction of 1 / n_operators
+#define PURSUIT_ADAPTATION 0.3
+#define PURSUIT_LEARNING_RATE 0.3
+#define PURSUIT_MIN_FRACTION 0.2
+
+// UCB: weight of the exploration term
+#define UCB_EXPLORATION 0.5
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Multi-armed bandit over the operators of one kind (selection,
+ * crossover, mutation...). The improvement produced by each operator and the
+ * time spent in it are recorded, possibly from several threads, and update()
+ * turns them into a reward, the improvement per second, once per generation.
+ * Adaptive pursuit draws the operators with probabilities that move towards
+ * the one with the best quality; UCB picks the operator with the best mean
+ * reward plus an exploration bonus
+ */
+class OperatorSelector {
+  public:
+    OperatorSelector(int n_operators, int policy = ADAPTIVE_PURSUIT);
+
+    int select(double random);
+    void record(int op, double gain, double elapsed);
+    void update();
+
+    int n_operators;
+    int policy;
+
+    // Quality of each operator, its probability (adaptive pursuit) and the
+    // number of times it has been used
+    vector<double> quality;
+    vector<double> probability;
+    vector<long long> n_uses;
+
+  private:
+    // Improvement and time recorded since the last update
+    vector<double> improvement;
+    vector<double> seconds;
+    vector<int> n_calls;
+
+    // Number of updates with a reward of each operator, for the UCB mean
+    vector<int> n_rewards;
+    int n_updates = 0;
+};
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * Implementation of a Max-SAT solver based on parallel tempering (replica
+ * exchange simulated annealing)
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef PARALLELTEMPERINGSOLVER_H
+#define PARALLELTEMPERINGSOLVER_H
+
+#include <time.h>
+#include <vector>
+
+#include "../include/MaxSATSolver.hpp"
+#include "../include/SimulatedAnnealingSolver.hpp"
+#include "../include/GreedyConstruction.hpp"
+
+/**
+ * @brief A MaxSAT solver that runs one simulated annealing chain per thread,
+ * each at a fixed temperature of a geometric ladder. After every temperature
+ * step, adjacent replicas swap temperatures with the Metropolis criterion and
+ * the best assignment of all the replicas becomes the incumbent
+ */
+class ParallelTemperingSolver : public MaxSATSolver {
+  public:
+    using MaxSATSolver::MaxSATSolver;
+
+    ParallelTemperingSolver(
+        const SATInstance &instance,
+        int n_replicas,
+        double min_temperature,
+        double max_temperature,
+        uint seed = time(NULL),
+        int construction = JOHNSON_CONSTRUCTION
+    );
+
+    virtual void solve();
+    void print_solution();
+
+    uint seed;
+    int construction;
+    int n_replicas;
+    int rounds = 0;
+    int n_swaps = 0;
+
+    vector<SimulatedAnnealingSolver> replicas;
+
+    // Temperature of each rung of the ladder, from the coldest, and the
+    // replica that is on each rung
+    vector<double> temperatures;
+    vector<int> rung_replica;
+
+    void exchange();
+};
+
+#endif
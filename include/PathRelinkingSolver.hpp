@@ -0,0 +1,73 @@
+/**
+ * Implementation of a Max-SAT solver based on path relinking between the
+ * members of an elite archive
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef PATHRELINKINGSOLVER_H
+#define PATHRELINKINGSOLVER_H
+
+#define MAX_RELINKS 10000
+#define RELINK_SAMPLES 50
+
+// Intensification used by the population based solvers, which relink their
+// archive every RELINK_INTERVAL generations when it is enabled
+#define ARCHIVE_SIZE 10
+#define ARCHIVE_DISTANCE_FRACTION 0.05
+#define RELINK_INTERVAL 10
+#define RELINK_PAIRS 4
+
+#include <cstdint>
+#include <time.h>
+#include <vector>
+
+#include "../include/MaxSATSolver.hpp"
+#include "../include/IncrementalEvaluator.hpp"
+#include "../include/EliteArchive.hpp"
+#include "../include/GreedyConstruction.hpp"
+
+/**
+ * @brief A MaxSAT solver that fills an elite archive with local optima and
+ * then walks from one member to another, flipping at each step the differing
+ * variable with the best score; the best assignment of the path is improved
+ * with local search and offered back to the archive
+ */
+class PathRelinkingSolver : public MaxSATSolver {
+  public:
+    using MaxSATSolver::MaxSATSolver;
+
+    PathRelinkingSolver(
+        const SATInstance &instance,
+        int archive_size,
+        int min_distance,
+        uint seed = time(NULL),
+        int construction = JOHNSON_CONSTRUCTION
+    );
+
+    virtual void solve();
+    void print_solution();
+
+    void intensify(EliteArchive &archive, int n_pairs);
+    int relink(const vector<bool> &initial, const vector<bool> &guiding);
+
+    uint seed;
+    int construction;
+    int relinks = 0;
+
+    EliteArchive archive;
+    IncrementalEvaluator evaluator;
+
+    // Variables that differ from the guiding assignment and flips of the
+    // current path
+    vector<int> diff;
+    vector<int> path;
+
+    void descend();
+
+  private:
+    uint64_t random_state;
+    uint32_t next_random();
+};
+
+#endif
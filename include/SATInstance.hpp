@@ -18,6 +18,7 @@ using namespace std;
 class SATInstance {
   public:
     SATInstance(string filename);
+    SATInstance(int n_vars, const vector<vector<int>> &clauses);
 
     int n_vars;
     int n_clauses;
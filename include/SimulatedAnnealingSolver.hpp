@@ -7,15 +7,36 @@
 #ifndef SIMULATEDANNEALINGSOLVER_H
 #define SIMULATEDANNEALINGSOLVER_H
 
-#define MAX_CYCLES 1000000
+#define MAX_PROPOSALS 10000000
 
+// Cooling schedules
+#define LOGARITHMIC_SCHEDULE 0
+#define GEOMETRIC_SCHEDULE 1
+#define ADAPTIVE_SCHEDULE 2
+#define REHEATING_SCHEDULE 3
+
+// Target acceptance ratio of worsening moves at the start of the adaptive
+// schedule, which decreases linearly to 0
+#define TARGET_ACCEPTANCE 0.3
+
+// Temperature steps without improvement before reheating, and fraction of the
+// initial temperature reheated to
+#define REHEAT_STEPS 100
+#define REHEAT_FRACTION 0.01
+
+#include <cstdint>
 #include <time.h>
 #include <vector>
 
 #include "../include/MaxSATSolver.hpp"
+#include "../include/IncrementalEvaluator.hpp"
+#include "../include/GreedyConstruction.hpp"
 
 /**
- * @brief A MaxSAT solver based on genetic algorithm
+ * @brief A MaxSAT solver based on simulated annealing. Each temperature step
+ * proposes n_vars random flips, accepted with the Metropolis rule on the
+ * change from the current assignment; the acceptance probabilities of every
+ * possible change are computed once per step
  */
 class SimulatedAnnealingSolver : public MaxSATSolver {
   public:
@@ -24,7 +45,8 @@ class SimulatedAnnealingSolver : public MaxSATSolver {
     SimulatedAnnealingSolver(
         const SATInstance &instance,
         double cooling_factor,
-        uint seed = time(NULL)
+        uint seed = time(NULL),
+        int construction = JOHNSON_CONSTRUCTION
     );
 
     virtual void solve();
@@ -32,16 +54,37 @@ class SimulatedAnnealingSolver : public MaxSATSolver {
     void print_solution();
 
     uint seed;
+    int construction;
+    int schedule = LOGARITHMIC_SCHEDULE;
     int iterations = 0;
+    int steps_without_improvement = 0;
+    long long n_proposals = 0;
     double initial_temperature;
     double temperature;
     double cooling_factor;
 
-    int eval_function(
-      vector<bool> &assignment, 
-      int flipped_var,
-      int current_n_satisfied
-    );
+    IncrementalEvaluator evaluator;
+
+    // Probability, scaled to 2^32, of accepting a flip that breaks k more
+    // clauses than it makes, for the current temperature
+    vector<uint32_t> acceptance;
+
+    // Assignment where the flip log starts, the flips applied since then and
+    // how many of them lead to the best assignment (-1 if it is not in the
+    // log, but already in optimal_assignment)
+    vector<bool> log_start;
+    vector<int> flip_log;
+    int best_step = -1;
+
+    void start();
+    double step();
+    void compute_acceptance();
+    void cool(double acceptance_ratio);
+    void save_best();
+
+  private:
+    uint64_t random_state;
+    uint32_t next_random();
 };
 
 #endif
@@ -12,6 +12,7 @@
 #include <time.h>
 
 #include "../include/MaxSATSolver.hpp"
+#include "../include/GreedyConstruction.hpp"
 
 /**
  * @brief A MaxSAT solver based on local search metaheuristic
@@ -24,7 +25,8 @@ class SolutionTreeSolver : public MaxSATSolver {
       int branching_factor,
       int max_depth,
       double alpha,
-      uint seed = time(NULL)
+      uint seed = time(NULL),
+      int construction = JOHNSON_CONSTRUCTION
     );
 
     int iteration = 0;
@@ -38,6 +40,7 @@ class SolutionTreeSolver : public MaxSATSolver {
     void print_solution();
 
     uint seed;
+    int construction;
 };
 
 #endif
\ No newline at end of file
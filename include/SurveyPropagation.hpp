@@ -0,0 +1,83 @@
+/**
+ * Survey propagation with decimation, used to build biased initial
+ * assignments for random k-SAT instances
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef SURVEYPROPAGATION_H
+#define SURVEYPROPAGATION_H
+
+#define MAX_SWEEPS 200
+#define SP_EPSILON 1e-3
+#define DECIMATION_FRACTION 0.01
+#define TRIVIAL_BIAS 0.01
+
+#include <time.h>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+
+using namespace std;
+
+/**
+ * @brief Runs survey propagation over the clause-variable graph and fixes the
+ * most biased variables, repeating over the simplified formula until the
+ * surveys become trivial. The sweeps are parallelised over the variables and
+ * the clauses
+ */
+class SurveyPropagation {
+  public:
+    SurveyPropagation(
+        const SATInstance &instance,
+        int n_threads,
+        uint seed = time(NULL)
+    );
+
+    vector<bool> compute_assignment();
+
+    uint seed;
+    int n_threads;
+
+    int sweeps = 0;
+    int n_decimated = 0;
+    bool converged = false;
+
+  private:
+    int n_vars;
+    int n_clauses;
+
+    // Edges of clause i are clause_start[i]..clause_start[i+1]-1, each one
+    // with its literal, the survey sent from the clause to its variable and
+    // the probability that the variable is forced not to satisfy the clause
+    vector<int> clause_start;
+    vector<int> edge_literal;
+    vector<int> edge_clause;
+    vector<double> survey;
+    vector<double> ratio;
+    vector<char> edge_active;
+    vector<char> clause_active;
+
+    // Edges of each variable
+    vector<vector<int>> var_edges;
+
+    // Value of each variable: -1 free, 0 false, 1 true
+    vector<int> value;
+
+    // Product of (1 - survey) over the positive and the negative active edges
+    // of each variable, leaving out the zero factors, which are counted apart
+    vector<double> product[2];
+    vector<int> n_zeros[2];
+
+    // Probability that each free variable is forced true (first) or false
+    vector<pair<double, double>> bias;
+
+    bool converge();
+    void compute_products();
+    double excluded_product(int var, int sign, int edge);
+    void compute_biases();
+    bool decimate();
+    void fix(int var, bool val);
+};
+
+#endif
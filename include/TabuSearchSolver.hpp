@@ -0,0 +1,68 @@
+/**
+ * Implementation of a Max-SAT solver based on tabu search
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef TABUSEARCHSOLVER_H
+#define TABUSEARCHSOLVER_H
+
+#define MAX_MOVES 5000000
+#define HASH_TABLE_BITS 16
+
+#include <time.h>
+#include <vector>
+
+#include "../include/MaxSATSolver.hpp"
+#include "../include/IncrementalEvaluator.hpp"
+
+/**
+ * @brief A MaxSAT solver based on tabu search with aspiration and reactive
+ * tabu tenure
+ */
+class TabuSearchSolver : public MaxSATSolver {
+  public:
+    using MaxSATSolver::MaxSATSolver;
+
+    TabuSearchSolver(
+        const SATInstance &instance,
+        int min_tenure,
+        int max_tenure,
+        uint seed = time(NULL)
+    );
+
+    virtual void solve();
+    void print_solution();
+
+    uint seed;
+    int moves = 0;
+    int min_tenure;
+    int max_tenure;
+    double tenure;
+
+    IncrementalEvaluator evaluator;
+
+    // Move in which each variable stops being tabu
+    vector<int> tabu_until;
+
+    // Variables grouped by score, bucket i holds the score i - max_score
+    int max_score;
+    int top_bucket;
+    vector<vector<int>> buckets;
+    vector<int> bucket_of;
+    vector<int> bucket_index;
+
+    // Hash of the current assignment and table of the last visit of a hash
+    unsigned long long hash;
+    vector<unsigned long long> var_hash;
+    vector<pair<unsigned long long, int>> visited;
+    int last_tenure_change = 0;
+
+    int pick_move();
+    void flip(int var);
+    void react();
+    void insert_var(int var);
+    void remove_var(int var);
+};
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ * Upper bound on the number of clauses of a Max-SAT instance that can be
+ * satisfied at the same time
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef UPPERBOUND_H
+#define UPPERBOUND_H
+
+#define UPPER_BOUND_CONFLICTS 2000
+#define UPPER_BOUND_CLAUSES 10000
+#define MIN_UPPER_BOUND_CONFLICTS 100
+
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/IncrementalEvaluator.hpp"
+#include "../include/CDCLEngine.hpp"
+
+using namespace std;
+
+/**
+ * @brief Computes an upper bound on the number of satisfiable clauses by
+ * finding disjoint inconsistent subsets of clauses: every one of them leaves
+ * at least one clause unsatisfied. Subsets are first found with unit
+ * propagation from the unit clauses and then as unsatisfiable cores of the
+ * remaining clauses, detected by a CDCL engine within a conflict budget
+ */
+class UpperBound {
+  public:
+    UpperBound(const SATInstance &instance);
+
+    int compute(long long max_conflicts = UPPER_BOUND_CONFLICTS);
+
+    int n_empty = 0;
+    int n_propagation_subsets = 0;
+    int n_core_subsets = 0;
+
+  private:
+    // Normalized clauses and occurrence lists
+    IncrementalEvaluator evaluator;
+
+    // Value of each variable: -1 unassigned, 0 false, 1 true
+    vector<int> value;
+    vector<int> n_true;
+    vector<int> n_false;
+    vector<int> reason;
+    vector<int> trail;
+
+    // Clauses that already belong to an inconsistent subset
+    vector<bool> used;
+
+    void count_propagation_subsets();
+    void count_core_subsets(long long max_conflicts);
+    int propagate(int from);
+    void assign(int var, bool val, int from);
+    void undo(int trail_size);
+};
+
+#endif
@@ -0,0 +1,53 @@
+/**
+ * Implementation of a Max-SAT solver based on variable neighborhood search
+ * (VNS)
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef VNSSOLVER_H
+#define VNSSOLVER_H
+
+#define MAX_SHAKES 1000000
+
+#include <time.h>
+#include <vector>
+
+#include "../include/MaxSATSolver.hpp"
+#include "../include/IncrementalEvaluator.hpp"
+
+/**
+ * @brief A MaxSAT solver based on variable neighborhood search, shaking with
+ * k random flips and descending with incremental local search
+ */
+class VNSSolver : public MaxSATSolver {
+  public:
+    using MaxSATSolver::MaxSATSolver;
+
+    VNSSolver(
+        const SATInstance &instance,
+        int k_min,
+        int k_max,
+        uint seed = time(NULL)
+    );
+
+    virtual void solve();
+    void print_solution();
+
+    uint seed;
+    int shakes = 0;
+    int k_min;
+    int k_max;
+
+    IncrementalEvaluator evaluator;
+
+    // Flips applied since the current solution was accepted
+    vector<int> flip_log;
+
+    void shake(int k);
+    void descend();
+    void undo();
+    void flip(int var);
+};
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * Work-stealing scheduler for independent tasks of uneven length
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <omp.h>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Runs a batch of tasks on a team of workers. Each worker starts with a
+ * contiguous block of the tasks in its own deque and takes them from the back;
+ * once it runs out, it steals from the front of the deque of another worker,
+ * so a worker stuck in a long task does not keep the others waiting. Tasks do
+ * not create new tasks, so a worker leaves when every deque is empty.
+ *
+ * Each worker also has a random generator for its tasks. It is restarted at
+ * every task from the seed, the batch and the task, so the numbers a task
+ * draws do not depend on the worker that steals it
+ */
+class WorkStealingPool {
+  public:
+    WorkStealingPool(int n_workers = 6);
+    ~WorkStealingPool();
+
+    // The locks of the deques cannot be copied
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    void run(int n_tasks, const function<void(int task, int worker)> &task);
+    uint32_t next_random(int worker);
+
+    int n_workers;
+    uint64_t seed = 1;
+
+    // Number of batches and tasks run and of tasks taken from another worker
+    long long n_batches = 0;
+    long long n_tasks_run = 0;
+    long long n_steals = 0;
+
+  private:
+    // Tasks and random generator of a worker, on its own cache line
+    struct alignas(64) TaskQueue {
+        deque<int> tasks;
+        omp_lock_t lock;
+        uint64_t random_state = 1;
+    };
+    vector<TaskQueue> queues;
+
+    void resize();
+    void start_task(int worker, int task);
+
+    bool pop(int worker, int &task);
+    bool steal(int worker, int n_active, int &task);
+};
+
+#endif
@@ -22,6 +22,8 @@
  * @param q0 The q0 parameter
  * @param tau0 The tau0 parameter
  * @param seed The seed for the random number generator
+ * @param construction The method that builds the initial assignment, see
+ * GreedyConstruction
  * @return ACOSolver:: 
  */
 ACOSolver::ACOSolver(
@@ -32,9 +34,11 @@ ACOSolver::ACOSolver(
     double rho,
     double q0,
     double tau0,
-    uint seed
+    uint seed,
+    int construction
 ) : MaxSATSolver(instance),
     seed(seed),
+    construction(construction),
     n_ants(n_ants),
     alpha(alpha),
     beta(beta),
@@ -78,36 +82,47 @@ ACOSolver::ACOSolver(
         heuristic.push_back(make_pair(count_neg, count_pos));
         // heuristic.push_back(make_pair(1.0, 1.0));
     }
+
+    // Seed the pheromones with the edges of a constructed solution
+    if (construction != RANDOM_CONSTRUCTION) {
+        optimal_assignment = GreedyConstruction(instance).construct(construction);
+        optimal_n_satisfied = compute_n_satisfied(optimal_assignment);
+        deposit_pheromones(optimal_assignment, optimal_n_satisfied);
+    }
 }
 
 /**
  * @brief Solves the SAT instance using the ACO algorithm
  */
 void ACOSolver::solve() {
+    compute_upper_bound();
+    pool.n_workers = n_threads;
+    pool.seed = seed;
+    ant_assignment.resize(n_ants);
+    ant_n_satisfied.resize(n_ants);
+
     // For each iteration
     for (int i = 0; i < MAX_SEARCHES; i++) {
         int internal_optimal_n_satisfied = 0;
         vector<bool> internal_optimal_assignment;
 
-        // For each ant
-        #pragma omp parallel for num_threads(6)
-        for (int j = 0; j < n_ants; j++) {
+        // Each ant is a task, balanced among the threads by work stealing
+        pool.run(n_ants, [&](int j, int worker) {
             // Generate a random solution
-            vector<bool> assignment = generate_solution();
+            ant_assignment[j] = generate_solution(worker);
 
             // Compute the number of satisfied clauses
-            int n_satisfied = compute_n_satisfied(assignment);
+            ant_n_satisfied[j] = compute_n_satisfied(ant_assignment[j]);
+        });
 
-            // If the solution is better than the current best, update the best
-            if (n_satisfied > internal_optimal_n_satisfied) {
-                internal_optimal_n_satisfied = n_satisfied;
-                internal_optimal_assignment = assignment;
+        // If the best ant is better than the current best, update the best
+        for (int j = 0; j < n_ants; j++) {
+            if (ant_n_satisfied[j] > internal_optimal_n_satisfied) {
+                internal_optimal_n_satisfied = ant_n_satisfied[j];
+                internal_optimal_assignment = ant_assignment[j];
             }
         }
 
-        optimal_found = instance.n_clauses == internal_optimal_n_satisfied;
-        if (optimal_found) break;
-
         // Applies local search to the best solution found by the current colony
         if (i % 10 == 0) {
             int i = 0;
@@ -137,7 +152,7 @@ void ACOSolver::solve() {
         }
 
         // If the solution is optimal, stop the search
-        optimal_found = instance.n_clauses == optimal_n_satisfied;
+        optimal_found = optimal_n_satisfied >= upper_bound;
         if (optimal_found) break;
 
         // Evaporate the pheromones
@@ -185,7 +200,13 @@ void ACOSolver::deposit_pheromones(const vector<bool> &assignment, int n_satisfi
     }
 }
 
-vector<bool> ACOSolver::generate_solution() {
+/**
+ * @brief Builds the assignment of an ant, walking the graph of the literals
+ *
+ * @param worker The worker of the pool that runs the ant
+ * @return vector<bool> The assignment
+ */
+vector<bool> ACOSolver::generate_solution(int worker) {
     // Initialize the solution vector
     vector<bool> assignment;
 
@@ -194,7 +215,7 @@ vector<bool> ACOSolver::generate_solution() {
     p = pow(src_pheromone.first, alpha) * pow(src_heuristic.first, beta);
     p /= p + pow(src_pheromone.second, alpha) * pow(src_heuristic.second, beta);
 
-    bool current_src = rand() >= p * RAND_MAX;
+    bool current_src = pool.next_random(worker) / 4294967296.0 >= p;
 
     int literal = current_src;
     int limit = 2*instance.n_vars - 3;
@@ -210,7 +231,7 @@ vector<bool> ACOSolver::generate_solution() {
 
         // Calculate the next node
         literal += 1 + !current_src;
-        current_src = rand() >= p * RAND_MAX;
+        current_src = pool.next_random(worker) / 4294967296.0 >= p;
         literal += current_src;
     }
 
@@ -226,6 +247,8 @@ void ACOSolver::print_solution() {
     cout << "c rho = " << rho << endl;
     cout << "c q0 = " << q0 << endl;
     cout << "c tau0 = " << tau0 << endl;
+    cout << "c n_threads = " << n_threads << endl;
+    cout << "c ants stolen = " << pool.n_steals << endl;
     cout << "c seed = " << seed << endl;
     MaxSATSolver::print_solution();
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+/**
+ * Backbone estimation from elite assignments and reduction of a Max-SAT
+ * instance to its free variables
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/Backbone.hpp"
+
+using namespace std;
+
+/**
+ * @brief Starts with every variable free
+ *
+ * @param instance The SAT instance
+ */
+Backbone::Backbone(const SATInstance &instance)
+    : value(instance.n_vars, -1), instance(instance) {}
+
+/**
+ * @brief Fixes every free variable that takes the same value in at least the
+ * given fraction of the solutions
+ *
+ * @param solutions Elite assignments, for instance the members of an
+ * EliteArchive
+ * @param agreement Fraction of the solutions that must agree
+ * @return int The number of variables fixed by this call
+ */
+int Backbone::estimate(const vector<vector<bool>> &solutions, double agreement) {
+    // A single solution agrees with itself on every variable
+    if (solutions.size() < 2) return 0;
+
+    int n_new = 0;
+    for (int i = 0; i < instance.n_vars; i++) {
+        if (value[i] != -1) continue;
+
+        int n_true = 0;
+        for (auto &solution : solutions) n_true += solution[i];
+
+        if (n_true >= agreement * solutions.size()) fix(i, true);
+        else if (solutions.size() - n_true >= agreement * solutions.size()) fix(i, false);
+        else continue;
+        n_new++;
+    }
+
+    return n_new;
+}
+
+/**
+ * @brief Fixes a variable to a value
+ */
+void Backbone::fix(int var, bool val) {
+    if (value[var] == -1) n_fixed++;
+    value[var] = val;
+}
+
+/**
+ * @brief Builds the instance over the free variables, numbered in their
+ * original order. Its optimum plus n_satisfied is the best that can be
+ * reached with the fixed values
+ *
+ * @return SATInstance The reduced instance
+ */
+SATInstance Backbone::reduce() {
+    vector<int> new_var(instance.n_vars, -1);
+    free_vars.clear();
+    for (int i = 0; i < instance.n_vars; i++) {
+        if (value[i] != -1) continue;
+        new_var[i] = free_vars.size();
+        free_vars.push_back(i);
+    }
+
+    n_satisfied = 0;
+    n_falsified = 0;
+
+    vector<vector<int>> clauses;
+    for (auto &clause : instance.clauses) {
+        vector<int> reduced;
+        bool satisfied = false;
+
+        for (int literal : clause) {
+            int var = literal>>1;
+            if (value[var] == -1) {
+                reduced.push_back(2 * new_var[var] + (literal & 1));
+            } else if ((literal & 1) != value[var]) {
+                satisfied = true;
+                break;
+            }
+        }
+
+        if (satisfied) n_satisfied++;
+        else if (reduced.empty()) n_falsified++;
+        else clauses.push_back(reduced);
+    }
+
+    return SATInstance(free_vars.size(), clauses);
+}
+
+/**
+ * @brief Completes an assignment of the last reduced instance with the fixed
+ * values
+ *
+ * @param reduced_assignment Assignment of the free variables
+ * @return vector<bool> Assignment of the original instance
+ */
+vector<bool> Backbone::extend(const vector<bool> &reduced_assignment) {
+    vector<bool> assignment(instance.n_vars);
+    for (int i = 0; i < instance.n_vars; i++) assignment[i] = value[i] == 1;
+    for (uint i = 0; i < free_vars.size(); i++)
+        assignment[free_vars[i]] = reduced_assignment[i];
+    return assignment;
+}
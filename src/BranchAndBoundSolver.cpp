@@ -0,0 +1,322 @@
+/**
+ * Implementation of an exact Max-SAT solver based on branch and bound
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/BranchAndBoundSolver.hpp"
+#include "../include/ClauseWeightingSolver.hpp"
+
+using namespace std;
+
+/**
+ * @brief Prepares the search over the instance to be solved
+ *
+ * @param instance The SAT instance
+ * @param seed The seed for the heuristic that computes the first incumbent
+ */
+BranchAndBoundSolver::BranchAndBoundSolver(const SATInstance &instance, uint seed)
+    : MaxSATSolver(instance),
+      seed(seed),
+      evaluator(instance),
+      value(instance.n_vars, -1),
+      n_true(instance.n_clauses, 0),
+      n_false(instance.n_clauses, 0),
+      n_occurrences(2 * instance.n_vars),
+      n_units(2 * instance.n_vars),
+      jw_score(2 * instance.n_vars),
+      reason(instance.n_vars, -1),
+      used(instance.n_clauses, 0)
+{
+    // Tautologies are always satisfied, empty clauses never
+    for (int i = 0; i < instance.n_clauses; i++) {
+        if (evaluator.tautology[i]) n_true[i] = 1;
+        else if (evaluator.clauses[i].empty()) n_falsified++;
+    }
+
+    optimal_assignment = vector<bool>(instance.n_vars, false);
+}
+
+/**
+ * @brief Solves the instance exactly. The search starts with the assignment
+ * found by a clause weighting local search as incumbent, so that the bound
+ * prunes from the first node, and is skipped if the incumbent already reaches
+ * the upper bound of the instance
+ */
+void BranchAndBoundSolver::solve() {
+    compute_upper_bound();
+
+    ClauseWeightingSolver heuristic(instance, 15, 0.01, 300, seed);
+    heuristic.set_upper_bound(upper_bound);
+    heuristic.solve();
+    optimal_assignment = heuristic.optimal_assignment;
+    optimal_n_satisfied = heuristic.optimal_n_satisfied;
+    best_n_falsified = instance.n_clauses - optimal_n_satisfied;
+
+    if (optimal_n_satisfied < upper_bound) branch();
+
+    // The optimum is proved unless the search was cut by MAX_NODES
+    optimal_found = nodes <= MAX_NODES;
+}
+
+/**
+ * @brief Explores the subtree of the current partial assignment, pruning it
+ * when its lower bound reaches the number of clauses unsatisfied by the best
+ * assignment found
+ */
+void BranchAndBoundSolver::branch() {
+    if (++nodes > MAX_NODES || optimal_n_satisfied >= upper_bound) return;
+
+    int trail_size = trail.size();
+
+    // Apply the pure literal and dominating unit clause rules
+    while (n_falsified < best_n_falsified && simplify());
+
+    bool preferred_value;
+    int var = choose_var(preferred_value);
+
+    if (n_falsified >= best_n_falsified) {
+        undo(trail_size);
+        return;
+    }
+
+    // Every clause is satisfied or falsified, a better assignment was found
+    if (var == -1) {
+        best_n_falsified = n_falsified;
+        save_solution();
+        undo(trail_size);
+        return;
+    }
+
+    if (n_falsified + count_inconsistent_subsets() >= best_n_falsified) {
+        undo(trail_size);
+        return;
+    }
+
+    for (bool val : {preferred_value, !preferred_value}) {
+        assign(var, val);
+        branch();
+        undo(trail.size() - 1);
+    }
+
+    undo(trail_size);
+}
+
+/**
+ * @brief Applies the pure literal rule (a literal whose negation appears in no
+ * open clause is set to true) and the dominating unit clause rule (a literal
+ * that appears in at least as many open unit clauses as its negation appears
+ * in open clauses is set to true). Both preserve some optimal assignment
+ *
+ * @return true if some variable was assigned
+ */
+bool BranchAndBoundSolver::simplify() {
+    fill(n_occurrences.begin(), n_occurrences.end(), 0);
+    fill(n_units.begin(), n_units.end(), 0);
+
+    for (int i = 0; i < instance.n_clauses; i++) {
+        int len = evaluator.clauses[i].size();
+        if (n_true[i] > 0 || n_false[i] == len) continue;
+
+        for (int literal : evaluator.clauses[i]) {
+            if (value[literal>>1] != -1) continue;
+            n_occurrences[literal]++;
+            if (n_false[i] == len - 1) n_units[literal]++;
+        }
+    }
+
+    bool assigned = false;
+    for (int literal = 0; literal < 2 * instance.n_vars; literal++) {
+        if (value[literal>>1] != -1 || !n_occurrences[literal]) continue;
+
+        if (n_units[literal] >= n_occurrences[literal ^ 1]) {
+            assign(literal>>1, !(literal & 1));
+            assigned = true;
+        }
+    }
+
+    return assigned;
+}
+
+/**
+ * @brief Chooses the unassigned variable with the highest Jeroslow-Wang score
+ * over the open clauses
+ *
+ * @param preferred_value [out] The value that satisfies the highest score
+ * @return int The variable, or -1 if there are no open clauses
+ */
+int BranchAndBoundSolver::choose_var(bool &preferred_value) {
+    fill(jw_score.begin(), jw_score.end(), 0);
+
+    for (int i = 0; i < instance.n_clauses; i++) {
+        int len = evaluator.clauses[i].size();
+        if (n_true[i] > 0 || n_false[i] == len) continue;
+
+        double weight = 1.0 / (1 << min(len - n_false[i], 30));
+        for (int literal : evaluator.clauses[i])
+            if (value[literal>>1] == -1) jw_score[literal] += weight;
+    }
+
+    int best = -1;
+    double best_score = 0;
+    for (int i = 0; i < instance.n_vars; i++) {
+        double score = jw_score[2*i] + jw_score[2*i + 1];
+        if (score > best_score) {
+            best_score = score;
+            best = i;
+        }
+    }
+
+    if (best != -1) preferred_value = jw_score[2*best] >= jw_score[2*best + 1];
+    return best;
+}
+
+/**
+ * @brief Lower bound on the number of open clauses that will be falsified:
+ * repeatedly runs unit propagation over the unused open clauses and, on each
+ * conflict, marks as used the clauses that produced it, which form an
+ * inconsistent subset disjoint from the previous ones
+ *
+ * @return int The number of disjoint inconsistent subsets found
+ */
+int BranchAndBoundSolver::count_inconsistent_subsets() {
+    stamp++;
+    int count = 0;
+
+    while (n_falsified + count < best_n_falsified) {
+        int trail_size = trail.size();
+        int conflict = -1;
+
+        for (int i = 0; i < instance.n_clauses && conflict == -1; i++) {
+            int len = evaluator.clauses[i].size();
+            if (used[i] == stamp || n_true[i] > 0 || n_false[i] != len - 1)
+                continue;
+
+            int literal = free_literal(i);
+            assign(literal>>1, !(literal & 1));
+            reason[literal>>1] = i;
+            conflict = propagate(trail.size() - 1);
+        }
+
+        if (conflict != -1) {
+            // Collect the clauses that lead to the conflict
+            vector<int> subset = {conflict};
+            used[conflict] = stamp;
+            for (uint j = 0; j < subset.size(); j++) {
+                for (int literal : evaluator.clauses[subset[j]]) {
+                    int r = reason[literal>>1];
+                    if (r != -1 && used[r] != stamp) {
+                        used[r] = stamp;
+                        subset.push_back(r);
+                    }
+                }
+            }
+            count++;
+        }
+
+        for (uint j = trail_size; j < trail.size(); j++) reason[trail[j]] = -1;
+        undo(trail_size);
+
+        if (conflict == -1) break;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Unit propagation over the unused clauses of the variables assigned
+ * from the given position of the trail
+ *
+ * @param from First position of the trail to propagate
+ * @return int A clause with every literal false, or -1 if there is none
+ */
+int BranchAndBoundSolver::propagate(int from) {
+    for (uint p = from; p < trail.size(); p++) {
+        int var = trail[p];
+        for (auto &occurrence : evaluator.occurrences[var]) {
+            int i = occurrence.first;
+            bool literal_true = (occurrence.second & 1) != value[var];
+            if (literal_true || used[i] == stamp || n_true[i] > 0) continue;
+
+            int len = evaluator.clauses[i].size();
+            if (n_false[i] == len) return i;
+            if (n_false[i] == len - 1) {
+                int literal = free_literal(i);
+                assign(literal>>1, !(literal & 1));
+                reason[literal>>1] = i;
+            }
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Returns the first literal of the clause whose variable is unassigned
+ */
+int BranchAndBoundSolver::free_literal(int clause) {
+    for (int literal : evaluator.clauses[clause])
+        if (value[literal>>1] == -1) return literal;
+    return -1;
+}
+
+void BranchAndBoundSolver::assign(int var, bool val) {
+    value[var] = val;
+    trail.push_back(var);
+
+    for (auto &occurrence : evaluator.occurrences[var]) {
+        int i = occurrence.first;
+        if ((occurrence.second & 1) != val) {
+            n_true[i]++;
+        } else {
+            n_false[i]++;
+            if (n_true[i] == 0 && n_false[i] == (int) evaluator.clauses[i].size())
+                n_falsified++;
+        }
+    }
+}
+
+/**
+ * @brief Unassigns the variables of the trail back to the given size
+ */
+void BranchAndBoundSolver::undo(int trail_size) {
+    while ((int) trail.size() > trail_size) {
+        int var = trail.back();
+        trail.pop_back();
+
+        for (auto &occurrence : evaluator.occurrences[var]) {
+            int i = occurrence.first;
+            if ((occurrence.second & 1) != value[var]) {
+                n_true[i]--;
+            } else {
+                if (n_true[i] == 0 && n_false[i] == (int) evaluator.clauses[i].size())
+                    n_falsified--;
+                n_false[i]--;
+            }
+        }
+
+        value[var] = -1;
+    }
+}
+
+/**
+ * @brief Saves the current assignment as the optimal one, unassigned variables
+ * appear in no open clause and are set to false
+ */
+void BranchAndBoundSolver::save_solution() {
+    for (int i = 0; i < instance.n_vars; i++)
+        optimal_assignment[i] = value[i] == 1;
+    optimal_n_satisfied = instance.n_clauses - n_falsified;
+}
+
+void BranchAndBoundSolver::print_solution() {
+    cout << "c Branch and Bound Solver" << endl;
+    cout << "c MAX_NODES = " << MAX_NODES << endl;
+    cout << "c nodes = " << nodes << endl;
+    cout << "c seed = " << seed << endl;
+    MaxSATSolver::print_solution();
+}
@@ -3,7 +3,9 @@
  *
  * Copyright (C) 2023 Christopher Gómez, Ka Fung
  */
+#include <cstdint>
 #include <iostream>
+#include <omp.h>
 #include <vector>
 
 #include "../include/SATInstance.hpp"
@@ -15,59 +17,111 @@ using namespace std;
  * @brief Generates an initial solution for the instance to be solved
  * 
  * @param instance The SAT instance
+ * @param n_threads Number of threads that enumerate the prefixes
  */
-BruteForceSolver::BruteForceSolver(const SATInstance &instance) : MaxSATSolver(instance) {
+BruteForceSolver::BruteForceSolver(const SATInstance &instance, int n_threads)
+    : MaxSATSolver(instance), n_threads(n_threads), occurrences(2 * instance.n_vars) {
     optimal_assignment = vector<bool>(instance.n_vars, false);
+
+    for (int i = 0; i < instance.n_clauses; i++)
+        for (int literal : instance.clauses[i]) occurrences[literal].push_back(i);
 }
 
 /**
  * Implementation of a MaxSAT solver with brute force
  */
 void BruteForceSolver::solve() {
-    // Initialize the assignment
-    vector<bool> assignment = optimal_assignment;
+    compute_upper_bound();
+
+    // The last n_prefix variables are fixed by each task
+    int n_prefix = min(instance.n_vars, PREFIX_BITS);
+    int n_free = instance.n_vars - n_prefix;
+    int n_tasks = 1 << n_prefix;
 
-    // Try every assignment
-    solve_helper(assignment, 0);
+    #pragma omp parallel for num_threads(n_threads) schedule(dynamic)
+    for (int prefix = 0; prefix < n_tasks; prefix++) enumerate(prefix, n_free);
 
     // Optimum is guaranteed to be found
     optimal_found = true;
 }
 
 /**
- * @brief Recursively generates all the possible assignments and computes the
- * n_satisfied_clauses of each one, stops when the optimal assignment is found
- * 
- * @param assignment 
- * @param i 
+ * @brief Enumerates in Gray code order every assignment of the first n_free
+ * variables, the rest taking the bits of the prefix. Step k flips the
+ * variable of the lowest set bit of k, and the assignment after step k is the
+ * Gray code k ^ (k >> 1), so only the best step is kept and the assignment is
+ * built once at the end
+ *
+ * @param prefix Values of the variables n_free, n_free + 1, ...
+ * @param n_free Number of variables enumerated
  */
-void BruteForceSolver::solve_helper(vector<bool> &assignment, int i) {
-    // If every clause is already satisfied, stop
-    if (optimal_found) return;
-
-    // If all the variables have been assigned
-    if (i == instance.n_vars) {
-        // Compute the n_satisfied_clauses of the assignment
-        int n_satisfied_clauses = compute_n_satisfied(assignment);
-
-        // Update the optimal assignment
-        if (n_satisfied_clauses > optimal_n_satisfied) {
-            optimal_n_satisfied = n_satisfied_clauses;
-            optimal_assignment = assignment;
+void BruteForceSolver::enumerate(uint64_t prefix, int n_free) {
+    // If the upper bound is already reached, stop
+    bool found;
+    #pragma omp atomic read
+    found = optimal_found;
+    if (found) return;
+
+    vector<bool> assignment(instance.n_vars, false);
+    for (int i = n_free; i < instance.n_vars; i++)
+        assignment[i] = (prefix >> (i - n_free)) & 1;
+
+    // Number of true literals of each clause
+    vector<int> n_true(instance.n_clauses, 0);
+    int n_satisfied = 0;
+    for (int i = 0; i < instance.n_clauses; i++) {
+        for (int literal : instance.clauses[i])
+            n_true[i] += instance.is_literal_true(literal, assignment);
+        n_satisfied += n_true[i] > 0;
+    }
+
+    int best_n_satisfied = n_satisfied;
+    uint64_t best_step = 0;
+
+    uint64_t n_steps = (uint64_t) 1 << n_free;
+    for (uint64_t k = 1; k < n_steps && best_n_satisfied < upper_bound; k++) {
+        int var = __builtin_ctzll(k);
+        bool value = !assignment[var];
+        assignment[var] = value;
+
+        // Clauses where the literal becomes true, then where it becomes false
+        for (int i : occurrences[2 * var + !value]) n_satisfied += n_true[i]++ == 0;
+        for (int i : occurrences[2 * var + value]) n_satisfied -= --n_true[i] == 0;
+
+        if (n_satisfied > best_n_satisfied) {
+            best_n_satisfied = n_satisfied;
+            best_step = k;
         }
 
-        optimal_found = instance.n_clauses == optimal_n_satisfied;
-        return;
+        // Another task may have reached the upper bound
+        if ((k & 0xFFFF) == 0) {
+            bool stop;
+            #pragma omp atomic read
+            stop = optimal_found;
+            if (stop) break;
+        }
     }
 
-    // Try assigning the variable to false
-    for (bool boolean : {false, true}) {
-        assignment[i] = boolean;
-        solve_helper(assignment, i+1);
+    uint64_t gray = best_step ^ (best_step >> 1);
+    for (int i = 0; i < n_free; i++) assignment[i] = (gray >> i) & 1;
+
+    #pragma omp critical
+    {
+        if (best_n_satisfied > optimal_n_satisfied) {
+            optimal_n_satisfied = best_n_satisfied;
+            optimal_assignment = assignment;
+        }
+
+        // Read without the lock by the other tasks
+        if (optimal_n_satisfied >= upper_bound) {
+            #pragma omp atomic write
+            optimal_found = true;
+        }
     }
 }
 
 void BruteForceSolver::print_solution() {
     cout << "c Brute Force Solver" << endl;
+    cout << "c n_threads = " << n_threads << endl;
     MaxSATSolver::print_solution();
-}
\ No newline at end of file
+}
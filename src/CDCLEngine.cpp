@@ -0,0 +1,482 @@
+/**
+ * A small conflict-driven clause learning (CDCL) SAT engine with incremental
+ * assumptions
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "../include/CDCLEngine.hpp"
+
+using namespace std;
+
+/**
+ * @brief Luby sequence (1, 1, 2, 1, 1, 2, 4, ...), used for the restarts
+ *
+ * @param i Index in the sequence
+ */
+static double luby(int i) {
+    int size = 1, seq = 0;
+    while (size < i + 1) {
+        seq++;
+        size = 2 * size + 1;
+    }
+
+    double x = 1;
+    while (size - 1 != i) {
+        size = (size - 1) >> 1;
+        seq--;
+        i = i % size;
+    }
+    for (int k = 0; k < seq; k++) x *= 2;
+    return x;
+}
+
+CDCLEngine::CDCLEngine() {}
+
+/**
+ * @brief Creates a new variable
+ *
+ * @return int The index of the variable
+ */
+int CDCLEngine::new_var() {
+    int var = n_vars++;
+
+    watches.push_back(vector<int>());
+    watches.push_back(vector<int>());
+    assigns.push_back(-1);
+    level.push_back(0);
+    reason.push_back(-1);
+    polarity.push_back(false);
+    activity.push_back(0);
+    heap_index.push_back(-1);
+    seen.push_back(false);
+    heap_insert(var);
+
+    return var;
+}
+
+/**
+ * @brief Adds a clause to the engine, simplified with the assignments of level
+ * zero
+ *
+ * @param literals The literals of the clause
+ * @return false if the clauses added so far are inconsistent
+ */
+bool CDCLEngine::add_clause(vector<int> literals) {
+    if (!ok) return false;
+    cancel_until(0);
+
+    sort(literals.begin(), literals.end());
+    vector<int> simplified;
+    for (uint i = 0; i < literals.size(); i++) {
+        int literal = literals[i];
+        // Satisfied clauses and tautologies are skipped
+        if (value(literal) == 1) return true;
+        if (i > 0 && literal == (literals[i-1] ^ 1)) return true;
+
+        if (value(literal) == 0) continue;
+        if (i > 0 && literal == literals[i-1]) continue;
+        simplified.push_back(literal);
+    }
+
+    if (simplified.empty()) {
+        ok = false;
+    } else if (simplified.size() == 1) {
+        enqueue(simplified[0], -1);
+        ok = propagate() == -1;
+    } else {
+        attach(simplified, false);
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Checks if the clauses are satisfiable with the assumption literals
+ * set to true
+ *
+ * @param assumptions Literals assumed to be true
+ * @param max_conflicts Conflicts allowed for this call, -1 for no limit
+ * @return int SAT_RESULT (and model is set), UNSAT_RESULT (and core is set) or
+ * UNKNOWN_RESULT if the conflict limit was reached
+ */
+int CDCLEngine::solve(const vector<int> &assumptions, long long max_conflicts) {
+    model.clear();
+    core.clear();
+    if (!ok) return UNSAT_RESULT;
+
+    long long start = conflicts;
+    int restarts = 0;
+    long long restart_conflicts = 0;
+    long long restart_limit = 100 * luby(restarts);
+
+    vector<int> learnt_clause;
+    while (true) {
+        int conflict = propagate();
+
+        if (conflict != -1) {
+            conflicts++;
+            restart_conflicts++;
+
+            // A conflict without decisions cannot be avoided
+            if (decision_level() == 0) {
+                ok = false;
+                return UNSAT_RESULT;
+            }
+
+            int backtrack_level;
+            analyze(conflict, learnt_clause, backtrack_level);
+            cancel_until(backtrack_level);
+
+            if (learnt_clause.size() == 1) {
+                enqueue(learnt_clause[0], -1);
+            } else {
+                int i = attach(learnt_clause, true);
+                enqueue(learnt_clause[0], i);
+            }
+
+            var_inc /= 0.95;
+            continue;
+        }
+
+        if (max_conflicts >= 0 && conflicts - start >= max_conflicts) {
+            cancel_until(0);
+            return UNKNOWN_RESULT;
+        }
+
+        if (restart_conflicts >= restart_limit) {
+            cancel_until(0);
+            restart_conflicts = 0;
+            restart_limit = 100 * luby(++restarts);
+            continue;
+        }
+
+        if (n_learnts - (int) trail.size() >= max_learnts) reduce_db();
+
+        // Decide the assumptions first, each on its own level
+        int next = -1;
+        while (decision_level() < (int) assumptions.size()) {
+            int p = assumptions[decision_level()];
+            if (value(p) == 1) {
+                trail_lim.push_back(trail.size());
+            } else if (value(p) == 0) {
+                analyze_final(p);
+                cancel_until(0);
+                return UNSAT_RESULT;
+            } else {
+                next = p;
+                break;
+            }
+        }
+
+        if (next == -1) {
+            int var = -1;
+            while (heap.size()) {
+                var = heap_pop();
+                if (assigns[var] == -1) break;
+                var = -1;
+            }
+
+            // Every variable is assigned without conflicts
+            if (var == -1) {
+                model = vector<bool>(n_vars);
+                for (int i = 0; i < n_vars; i++) model[i] = assigns[i] == 1;
+                cancel_until(0);
+                return SAT_RESULT;
+            }
+
+            next = 2 * var + !polarity[var];
+        }
+
+        trail_lim.push_back(trail.size());
+        enqueue(next, -1);
+    }
+}
+
+/**
+ * @brief Value of a literal: -1 unassigned, 0 false, 1 true
+ */
+int CDCLEngine::value(int literal) {
+    int a = assigns[literal>>1];
+    return a < 0 ? -1 : a ^ (literal & 1);
+}
+
+int CDCLEngine::decision_level() {
+    return trail_lim.size();
+}
+
+/**
+ * @brief Sets a literal to true
+ *
+ * @param literal The literal
+ * @param from The clause that implies it, or -1 for decisions
+ */
+void CDCLEngine::enqueue(int literal, int from) {
+    int var = literal>>1;
+    assigns[var] = !(literal & 1);
+    level[var] = decision_level();
+    reason[var] = from;
+    trail.push_back(literal);
+}
+
+/**
+ * @brief Propagates the literals of the trail through the watched literals
+ *
+ * @return int A conflicting clause, or -1 if there is none
+ */
+int CDCLEngine::propagate() {
+    while (qhead < trail.size()) {
+        int false_literal = trail[qhead++] ^ 1;
+        vector<int> &ws = watches[false_literal];
+
+        uint i = 0, j = 0;
+        while (i < ws.size()) {
+            int ci = ws[i++];
+            if (deleted[ci]) continue;
+
+            // Keep the false literal in the second position
+            vector<int> &c = clauses[ci];
+            if (c[0] == false_literal) swap(c[0], c[1]);
+
+            if (value(c[0]) == 1) {
+                ws[j++] = ci;
+                continue;
+            }
+
+            // Look for a new literal to watch
+            bool found = false;
+            for (uint k = 2; k < c.size(); k++) {
+                if (value(c[k]) != 0) {
+                    swap(c[1], c[k]);
+                    watches[c[1]].push_back(ci);
+                    found = true;
+                    break;
+                }
+            }
+            if (found) continue;
+
+            ws[j++] = ci;
+            if (value(c[0]) == 0) {
+                while (i < ws.size()) ws[j++] = ws[i++];
+                ws.resize(j);
+                qhead = trail.size();
+                return ci;
+            }
+            enqueue(c[0], ci);
+        }
+        ws.resize(j);
+    }
+
+    return -1;
+}
+
+/**
+ * @brief First UIP conflict analysis
+ *
+ * @param conflict The conflicting clause
+ * @param out_learnt [out] The learnt clause, asserting literal first and a
+ * literal of the backtrack level second
+ * @param out_level [out] The level to backtrack to
+ */
+void CDCLEngine::analyze(int conflict, vector<int> &out_learnt, int &out_level) {
+    out_learnt.assign(1, -1);
+
+    int path = 0;
+    int p = -1;
+    int index = trail.size() - 1;
+
+    do {
+        vector<int> &c = clauses[conflict];
+        for (uint j = (p == -1 ? 0 : 1); j < c.size(); j++) {
+            int var = c[j]>>1;
+            if (seen[var] || level[var] == 0) continue;
+
+            bump(var);
+            seen[var] = true;
+            if (level[var] >= decision_level()) path++;
+            else out_learnt.push_back(c[j]);
+        }
+
+        // Next literal of the current level in the trail
+        while (!seen[trail[index]>>1]) index--;
+        p = trail[index--];
+        conflict = reason[p>>1];
+        seen[p>>1] = false;
+        path--;
+    } while (path > 0);
+    out_learnt[0] = p ^ 1;
+
+    out_level = 0;
+    if (out_learnt.size() > 1) {
+        uint max_i = 1;
+        for (uint i = 2; i < out_learnt.size(); i++)
+            if (level[out_learnt[i]>>1] > level[out_learnt[max_i]>>1]) max_i = i;
+        swap(out_learnt[1], out_learnt[max_i]);
+        out_level = level[out_learnt[1]>>1];
+    }
+
+    for (int literal : out_learnt) seen[literal>>1] = false;
+}
+
+/**
+ * @brief Computes the assumptions that imply the negation of a failed one
+ *
+ * @param literal An assumption that is false
+ */
+void CDCLEngine::analyze_final(int literal) {
+    core.clear();
+    core.push_back(literal);
+    if (decision_level() == 0) return;
+
+    seen[literal>>1] = true;
+    for (int i = trail.size() - 1; i >= trail_lim[0]; i--) {
+        int var = trail[i]>>1;
+        if (!seen[var]) continue;
+
+        if (reason[var] == -1) {
+            // Decisions below the assumption levels are assumptions
+            core.push_back(trail[i]);
+        } else {
+            vector<int> &c = clauses[reason[var]];
+            for (uint j = 1; j < c.size(); j++)
+                if (level[c[j]>>1] > 0) seen[c[j]>>1] = true;
+        }
+        seen[var] = false;
+    }
+    seen[literal>>1] = false;
+}
+
+/**
+ * @brief Undoes every assignment above the given level
+ */
+void CDCLEngine::cancel_until(int lvl) {
+    if (decision_level() <= lvl) return;
+
+    for (int i = trail.size() - 1; i >= trail_lim[lvl]; i--) {
+        int var = trail[i]>>1;
+        polarity[var] = assigns[var] == 1;
+        assigns[var] = -1;
+        reason[var] = -1;
+        heap_insert(var);
+    }
+
+    trail.resize(trail_lim[lvl]);
+    trail_lim.resize(lvl);
+    qhead = trail.size();
+}
+
+int CDCLEngine::attach(vector<int> &literals, bool is_learnt) {
+    int i = clauses.size();
+    clauses.push_back(literals);
+    learnt.push_back(is_learnt);
+    deleted.push_back(false);
+
+    // Literal block distance: number of distinct levels of the clause
+    int distance = 0;
+    if (is_learnt) {
+        vector<int> levels;
+        for (int literal : literals) levels.push_back(level[literal>>1]);
+        sort(levels.begin(), levels.end());
+        distance = unique(levels.begin(), levels.end()) - levels.begin();
+        n_learnts++;
+    }
+    lbd.push_back(distance);
+
+    watches[literals[0]].push_back(i);
+    watches[literals[1]].push_back(i);
+    return i;
+}
+
+/**
+ * @brief Removes half of the learnt clauses, the ones with the highest literal
+ * block distance, keeping binary clauses and reasons
+ */
+void CDCLEngine::reduce_db() {
+    vector<int> candidates;
+    for (uint i = 0; i < clauses.size(); i++)
+        if (learnt[i] && !deleted[i] && clauses[i].size() > 2 && !locked(i))
+            candidates.push_back(i);
+
+    sort(candidates.begin(), candidates.end(), [&](int a, int b) {
+        return lbd[a] > lbd[b];
+    });
+
+    for (uint k = 0; k < candidates.size() / 2; k++) {
+        int i = candidates[k];
+        deleted[i] = true;
+        vector<int>().swap(clauses[i]);
+        n_learnts--;
+    }
+
+    max_learnts += max_learnts / 10;
+}
+
+/**
+ * @brief A clause is locked while it is the reason of an assignment
+ */
+bool CDCLEngine::locked(int clause) {
+    int var = clauses[clause][0]>>1;
+    return reason[var] == clause && value(clauses[clause][0]) == 1;
+}
+
+void CDCLEngine::bump(int var) {
+    activity[var] += var_inc;
+    if (activity[var] > 1e100) {
+        for (double &a : activity) a *= 1e-100;
+        var_inc *= 1e-100;
+    }
+    if (heap_index[var] != -1) heap_up(heap_index[var]);
+}
+
+void CDCLEngine::heap_insert(int var) {
+    if (heap_index[var] != -1) return;
+    heap_index[var] = heap.size();
+    heap.push_back(var);
+    heap_up(heap_index[var]);
+}
+
+int CDCLEngine::heap_pop() {
+    int var = heap[0];
+    heap_index[var] = -1;
+
+    int last = heap.back();
+    heap.pop_back();
+    if (heap.size()) {
+        heap[0] = last;
+        heap_index[last] = 0;
+        heap_down(0);
+    }
+    return var;
+}
+
+void CDCLEngine::heap_up(int i) {
+    int var = heap[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (activity[heap[parent]] >= activity[var]) break;
+        heap[i] = heap[parent];
+        heap_index[heap[i]] = i;
+        i = parent;
+    }
+    heap[i] = var;
+    heap_index[var] = i;
+}
+
+void CDCLEngine::heap_down(int i) {
+    int var = heap[i];
+    int size = heap.size();
+    while (2 * i + 1 < size) {
+        int child = 2 * i + 1;
+        if (child + 1 < size && activity[heap[child + 1]] > activity[heap[child]])
+            child++;
+        if (activity[heap[child]] <= activity[var]) break;
+        heap[i] = heap[child];
+        heap_index[heap[i]] = i;
+        i = child;
+    }
+    heap[i] = var;
+    heap_index[var] = i;
+}
@@ -0,0 +1,134 @@
+/**
+ * Clause-based crossover with greedy repair for Max-SAT
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/ClauseCrossover.hpp"
+
+using namespace std;
+
+/**
+ * @param instance The SAT instance
+ */
+ClauseCrossover::ClauseCrossover(const SATInstance &instance)
+    : evaluator(instance), value(instance.n_vars)
+{
+}
+
+/**
+ * @brief Builds a child from two parents and repairs it. The clauses are
+ * visited from the given one on, so the parents can produce different
+ * children; the variables that no clause decides are taken from the first
+ * parent
+ *
+ * @param parent1 The first parent
+ * @param parent2 The second parent
+ * @param start The first clause visited
+ * @param child [out] The child
+ * @return int The number of clauses satisfied by the child
+ */
+int ClauseCrossover::cross(
+    const vector<bool> &parent1,
+    const vector<bool> &parent2,
+    int start,
+    vector<bool> &child
+) {
+    int n_clauses = evaluator.n_clauses;
+    fill(value.begin(), value.end(), -1);
+
+    // Clauses satisfied by a single parent take its values
+    for (int k = 0; k < n_clauses; k++) {
+        int i = (start + k) % n_clauses;
+        bool satisfied1 = satisfies(i, parent1);
+        if (satisfied1 != satisfies(i, parent2))
+            assign(i, satisfied1 ? parent1 : parent2);
+    }
+
+    // Clauses satisfied by both parents that the child does not satisfy yet
+    // take the values of a parent with a true literal still unassigned
+    for (int k = 0; k < n_clauses; k++) {
+        int i = (start + k) % n_clauses;
+        if (!satisfies(i, parent1) || !satisfies(i, parent2)) continue;
+
+        bool satisfied = false, free1 = false;
+        for (int literal : evaluator.clauses[i]) {
+            int var = literal>>1;
+            if (value[var] == -1) free1 |= (literal & 1) != parent1[var];
+            else satisfied |= (literal & 1) != value[var];
+        }
+        if (!satisfied) assign(i, free1 ? parent1 : parent2);
+    }
+
+    child = parent1;
+    for (int var = 0; var < evaluator.n_vars; var++)
+        if (value[var] != -1) child[var] = value[var];
+
+    evaluator.reset(child);
+    repair(parent1, parent2);
+
+    child = evaluator.assignment;
+    n_children++;
+    return evaluator.n_satisfied;
+}
+
+/**
+ * @brief Checks if an assignment satisfies a clause. Tautologies are empty,
+ * so they are never taken from a parent
+ *
+ * @param clause The clause
+ * @param assignment The assignment
+ */
+bool ClauseCrossover::satisfies(int clause, const vector<bool> &assignment) {
+    for (int literal : evaluator.clauses[clause])
+        if ((literal & 1) != assignment[literal>>1]) return true;
+    return false;
+}
+
+/**
+ * @brief Takes from a parent the value of the unassigned variables of a clause
+ *
+ * @param clause The clause
+ * @param parent The parent
+ */
+void ClauseCrossover::assign(int clause, const vector<bool> &parent) {
+    for (int literal : evaluator.clauses[clause]) {
+        int var = literal>>1;
+        if (value[var] == -1) value[var] = parent[var];
+    }
+}
+
+/**
+ * @brief Visits once the clauses that the child leaves unsatisfied but a
+ * parent satisfies, flipping in each one the variable that satisfies the most
+ * clauses, as long as it satisfies more clauses than it breaks
+ *
+ * @param parent1 The first parent
+ * @param parent2 The second parent
+ */
+void ClauseCrossover::repair(const vector<bool> &parent1, const vector<bool> &parent2) {
+    broken = evaluator.unsat_clauses;
+
+    for (int i : broken) {
+        if (evaluator.n_true[i] > 0) continue;
+        if (!satisfies(i, parent1) && !satisfies(i, parent2)) continue;
+
+        int best = -1, best_delta = 0;
+        for (int literal : evaluator.clauses[i]) {
+            int delta = evaluator.delta(literal>>1);
+            if (delta > best_delta) {
+                best = literal>>1;
+                best_delta = delta;
+            }
+        }
+
+        if (best != -1) {
+            evaluator.flip(best);
+            n_repairs++;
+        }
+    }
+}
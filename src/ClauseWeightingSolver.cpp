@@ -0,0 +1,162 @@
+/**
+ * Implementation of a Max-SAT solver based on dynamic clause weighting
+ * (SATLike-style)
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/ClauseWeightingSolver.hpp"
+
+using namespace std;
+
+/**
+ * @brief Generates an initial solution for the instance to be solved, using
+ * the given seed
+ *
+ * @param instance The SAT instance
+ * @param bms_samples Number of good variables sampled on each greedy step
+ * @param smooth_probability Probability of smoothing the weights instead of
+ * increasing them at a local optimum
+ * @param max_weight Upper bound for the weight of a clause
+ * @param seed The seed for the random number generator
+ */
+ClauseWeightingSolver::ClauseWeightingSolver(
+    const SATInstance &instance,
+    int bms_samples,
+    double smooth_probability,
+    int max_weight,
+    uint seed
+) : MaxSATSolver(instance),
+    seed(seed),
+    bms_samples(bms_samples),
+    smooth_probability(smooth_probability),
+    max_weight(max_weight),
+    evaluator(instance),
+    last_flip(instance.n_vars, 0)
+{
+    // Initialize the optimal assignment with random values
+    srand(seed);
+    for (int i = 0; i < instance.n_vars; i++)
+        optimal_assignment.push_back(rand() & 1);
+}
+
+/**
+ * @brief Solves the instance flipping greedily the variables with positive
+ * weighted score; at a local optimum the weights of the unsatisfied clauses
+ * are increased (or smoothed) and a variable of a random unsatisfied clause
+ * is flipped
+ */
+void ClauseWeightingSolver::solve() {
+    compute_upper_bound();
+
+    evaluator.reset(optimal_assignment);
+    optimal_n_satisfied = evaluator.n_satisfied;
+
+    while (flips < max_flips) {
+        if (evaluator.n_satisfied > optimal_n_satisfied) {
+            optimal_n_satisfied = evaluator.n_satisfied;
+            optimal_assignment = evaluator.assignment;
+        }
+
+        optimal_found = optimal_n_satisfied >= upper_bound;
+        if (optimal_found || evaluator.unsat_clauses.empty()) break;
+
+        int var;
+        if (evaluator.good_vars.size()) {
+            var = pick_bms_var();
+        } else {
+            update_weights();
+            int k = rand() % evaluator.unsat_clauses.size();
+            var = pick_clause_var(evaluator.unsat_clauses[k]);
+        }
+
+        flip(var);
+        flips++;
+    }
+}
+
+/**
+ * @brief Best from multiple selection: samples bms_samples good variables and
+ * returns the one with the highest score, breaking ties by age
+ */
+int ClauseWeightingSolver::pick_bms_var() {
+    vector<int> &good_vars = evaluator.good_vars;
+    int n_good = good_vars.size();
+    if (n_good <= bms_samples) {
+        int best = good_vars[0];
+        for (int var : good_vars) {
+            if (evaluator.score[var] > evaluator.score[best] ||
+                (evaluator.score[var] == evaluator.score[best] &&
+                 last_flip[var] < last_flip[best]))
+                best = var;
+        }
+        return best;
+    }
+
+    int best = good_vars[rand() % n_good];
+    for (int i = 1; i < bms_samples; i++) {
+        int var = good_vars[rand() % n_good];
+        if (evaluator.score[var] > evaluator.score[best] ||
+            (evaluator.score[var] == evaluator.score[best] &&
+             last_flip[var] < last_flip[best]))
+            best = var;
+    }
+    return best;
+}
+
+/**
+ * @brief Returns the variable of the clause with the highest score, breaking
+ * ties by age
+ *
+ * @param clause An unsatisfied clause
+ */
+int ClauseWeightingSolver::pick_clause_var(int clause) {
+    const vector<int> &literals = evaluator.clauses[clause];
+    int best = literals[0]>>1;
+    for (int literal : literals) {
+        int var = literal>>1;
+        if (evaluator.score[var] > evaluator.score[best] ||
+            (evaluator.score[var] == evaluator.score[best] &&
+             last_flip[var] < last_flip[best]))
+            best = var;
+    }
+    return best;
+}
+
+/**
+ * @brief At a local optimum, with probability smooth_probability decrease by
+ * one the weight of every satisfied clause with weight above one; otherwise
+ * increase by one the weight of every unsatisfied clause below max_weight
+ */
+void ClauseWeightingSolver::update_weights() {
+    if ((double) rand() / RAND_MAX < smooth_probability) {
+        for (int i = 0; i < instance.n_clauses; i++)
+            if (evaluator.weight[i] > 1 && evaluator.n_true[i] > 0)
+                evaluator.add_weight(i, -1);
+    } else {
+        for (int i : evaluator.unsat_clauses)
+            if (evaluator.weight[i] < max_weight) evaluator.add_weight(i, 1);
+    }
+
+    evaluator.update_good_vars();
+}
+
+void ClauseWeightingSolver::flip(int var) {
+    evaluator.flip(var);
+    last_flip[var] = flips;
+    evaluator.update_good_vars();
+}
+
+void ClauseWeightingSolver::print_solution() {
+    cout << "c Clause Weighting Solver" << endl;
+    cout << "c max_flips = " << max_flips << endl;
+    cout << "c bms_samples = " << bms_samples << endl;
+    cout << "c smooth_probability = " << smooth_probability << endl;
+    cout << "c max_weight = " << max_weight << endl;
+    cout << "c seed = " << seed << endl;
+    MaxSATSolver::print_solution();
+}
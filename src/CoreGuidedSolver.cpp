@@ -0,0 +1,205 @@
+/**
+ * Implementation of an exact Max-SAT solver guided by unsatisfiable cores
+ * (OLL)
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/CoreGuidedSolver.hpp"
+#include "../include/GreedyConstruction.hpp"
+
+using namespace std;
+
+/**
+ * @brief Loads the clauses of the instance in the engine, each one relaxed
+ * with a selector variable that is assumed false
+ *
+ * @param instance The SAT instance
+ */
+CoreGuidedSolver::CoreGuidedSolver(const SATInstance &instance)
+    : MaxSATSolver(instance)
+{
+    for (int i = 0; i < instance.n_vars; i++) engine.new_var();
+
+    for (int i = 0; i < instance.n_clauses; i++) {
+        // Empty clauses can never be satisfied, so they are left out
+        if (instance.clauses[i].empty()) continue;
+
+        int selector = engine.new_var();
+        vector<int> literals = instance.clauses[i];
+        literals.push_back(2 * selector);
+        engine.add_clause(literals);
+        assumptions.push_back(2 * selector + 1);
+    }
+
+    totalizer_of = vector<int>(engine.n_vars, -1);
+    output_index = vector<int>(engine.n_vars, -1);
+
+    // Incumbent reported if the conflict budget runs out before the optimum
+    optimal_assignment = GreedyConstruction(instance).construct(JOHNSON_CONSTRUCTION);
+    optimal_n_satisfied = compute_n_satisfied(optimal_assignment);
+}
+
+/**
+ * @brief Solves the instance with the OLL algorithm: while the formula is
+ * unsatisfiable under the assumptions, the core found costs at least one more
+ * clause, so its assumptions are replaced by the constraint that at most one
+ * of them is violated. Once the assumptions are satisfiable, the model
+ * violates exactly as many clauses as the lower bound, so it is optimal
+ */
+void CoreGuidedSolver::solve() {
+    while (engine.conflicts < MAX_CONFLICTS) {
+        int result = engine.solve(assumptions, MAX_CONFLICTS - engine.conflicts);
+        if (result == UNKNOWN_RESULT) break;
+
+        if (result == SAT_RESULT) {
+            for (int i = 0; i < instance.n_vars; i++)
+                optimal_assignment[i] = engine.model[i];
+            optimal_n_satisfied = compute_n_satisfied(optimal_assignment);
+            optimal_found = true;
+            break;
+        }
+
+        // Only the assumptions can make the formula unsatisfiable
+        if (engine.core.empty()) break;
+
+        vector<int> core = engine.core;
+        minimize_core(core);
+        relax(core);
+
+        lower_bound++;
+        n_cores++;
+    }
+}
+
+/**
+ * @brief Shrinks a core: first it is trimmed, solving again under only its
+ * assumptions while that gives a smaller core, then each assumption is
+ * dropped if the rest is still unsatisfiable within a small conflict budget.
+ * Both share the conflict budget of the search, and the core is kept as it is
+ * when the budget runs out
+ *
+ * @param core [in/out] Assumption literals of the core
+ */
+void CoreGuidedSolver::minimize_core(vector<int> &core) {
+    for (int i = 0; i < 3; i++) {
+        long long budget = MAX_CONFLICTS - engine.conflicts;
+        if (budget <= 0 || engine.solve(core, budget) != UNSAT_RESULT) return;
+        if (engine.core.size() >= core.size()) break;
+        core = engine.core;
+    }
+
+    for (uint i = 0; i < core.size() && core.size() > 1; ) {
+        long long budget = min((long long) MINIMIZE_CONFLICTS, MAX_CONFLICTS - engine.conflicts);
+        if (budget <= 0) return;
+
+        vector<int> candidate = core;
+        candidate.erase(candidate.begin() + i);
+
+        if (engine.solve(candidate, budget) == UNSAT_RESULT) {
+            core = engine.core;
+            continue;
+        }
+        i++;
+    }
+}
+
+/**
+ * @brief Replaces the assumptions of a core by a totalizer over the negated
+ * assumptions, assuming that at most one of them is true. Assumptions that
+ * bound the sum of an older totalizer to k are replaced by the bound k + 1
+ *
+ * @param core Assumption literals of the core
+ */
+void CoreGuidedSolver::relax(const vector<int> &core) {
+    vector<bool> in_core(engine.n_vars, false);
+    for (int literal : core) in_core[literal>>1] = true;
+
+    vector<int> remaining;
+    for (int literal : assumptions)
+        if (!in_core[literal>>1]) remaining.push_back(literal);
+    assumptions = remaining;
+
+    // Relax the bound of the totalizers in the core
+    for (int literal : core) {
+        int t = totalizer_of[literal>>1];
+        if (t == -1) continue;
+
+        uint next = output_index[literal>>1] + 1;
+        if (next < totalizers[t].size())
+            assumptions.push_back(2 * totalizers[t][next] + 1);
+    }
+
+    if (core.size() == 1) return;
+
+    // The inputs are the violations: the negations of the assumptions
+    vector<int> inputs;
+    for (int literal : core) inputs.push_back(literal ^ 1);
+    vector<int> outputs = build_totalizer(inputs, 0, inputs.size());
+
+    int t = totalizers.size();
+    vector<int> output_vars;
+    for (int literal : outputs) output_vars.push_back(literal>>1);
+    totalizers.push_back(output_vars);
+
+    totalizer_of.resize(engine.n_vars, -1);
+    output_index.resize(engine.n_vars, -1);
+    for (uint k = 0; k < output_vars.size(); k++) {
+        totalizer_of[output_vars[k]] = t;
+        output_index[output_vars[k]] = k;
+    }
+
+    // At most one of the inputs is true
+    assumptions.push_back(2 * output_vars[1] + 1);
+}
+
+/**
+ * @brief Builds a totalizer over a range of literals, with the clauses that
+ * force output k to be true when more than k inputs are true
+ *
+ * @param inputs The literals to count
+ * @param from First position of the range
+ * @param to Position after the last of the range
+ * @return vector<int> The (positive) output literals
+ */
+vector<int> CoreGuidedSolver::build_totalizer(
+    const vector<int> &inputs,
+    int from,
+    int to
+) {
+    if (to - from == 1) return {inputs[from]};
+
+    int middle = (from + to) / 2;
+    vector<int> left = build_totalizer(inputs, from, middle);
+    vector<int> right = build_totalizer(inputs, middle, to);
+
+    vector<int> outputs;
+    for (int k = 0; k < to - from; k++) outputs.push_back(2 * engine.new_var());
+
+    // i true on the left and j true on the right imply i + j true outputs
+    for (uint i = 0; i <= left.size(); i++) {
+        for (uint j = 0; j <= right.size(); j++) {
+            if (i + j == 0) continue;
+
+            vector<int> clause = {outputs[i + j - 1]};
+            if (i > 0) clause.push_back(left[i - 1] ^ 1);
+            if (j > 0) clause.push_back(right[j - 1] ^ 1);
+            engine.add_clause(clause);
+        }
+    }
+
+    return outputs;
+}
+
+void CoreGuidedSolver::print_solution() {
+    cout << "c Core Guided Solver" << endl;
+    cout << "c MAX_CONFLICTS = " << MAX_CONFLICTS << endl;
+    cout << "c cores = " << n_cores << endl;
+    cout << "c conflicts = " << engine.conflicts << endl;
+    MaxSATSolver::print_solution();
+}
@@ -0,0 +1,75 @@
+/**
+ * Diversity of the population of an evolutionary algorithm
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "../include/DiversityMonitor.hpp"
+
+using namespace std;
+
+/**
+ * @param n_vars Number of variables of the individuals
+ * @param threshold Diversity under which the population has collapsed
+ */
+DiversityMonitor::DiversityMonitor(int n_vars, double threshold)
+    : n_vars(n_vars), threshold(threshold), n_true(n_vars)
+{
+}
+
+/**
+ * @brief Computes the mean Hamming distance between two individuals of the
+ * population, divided by the number of variables, and adds it to the trace
+ *
+ * @param population The population
+ * @return double The diversity, from 0 (all equal) to about 0.5 (random)
+ */
+double DiversityMonitor::measure(const vector<vector<bool>> &population) {
+    long long n = population.size();
+    if (n < 2 || !n_vars) {
+        trace.push_back(0);
+        streak++;
+        return 0;
+    }
+
+    fill(n_true.begin(), n_true.end(), 0);
+    for (auto &individual : population)
+        for (int i = 0; i < n_vars; i++) n_true[i] += individual[i];
+
+    long long n_differences = 0;
+    for (int i = 0; i < n_vars; i++) n_differences += n_true[i] * (n - n_true[i]);
+
+    double diversity = n_differences / (n * (n - 1) / 2.0) / n_vars;
+    trace.push_back(diversity);
+    if (diversity < threshold) n_collapses++, streak++;
+    else streak = 0;
+    return diversity;
+}
+
+/**
+ * @brief Checks if the last diversity measured is under the threshold
+ */
+bool DiversityMonitor::collapsed() {
+    return trace.size() && trace.back() < threshold;
+}
+
+/**
+ * @brief Prints TRACE_POINTS values of the trace, evenly spaced, and the
+ * number of collapses
+ */
+void DiversityMonitor::print_trace() {
+    cout << "c diversity collapses = " << n_collapses << endl;
+    if (trace.empty()) return;
+
+    int step = max(1, (int) trace.size() / TRACE_POINTS);
+    streamsize precision = cout.precision();
+    cout << "c diversity trace (every " << step << " generations) =";
+    cout << fixed << setprecision(4);
+    for (size_t i = 0; i < trace.size(); i += step) cout << " " << trace[i];
+    cout << defaultfloat << setprecision(precision) << endl;
+}
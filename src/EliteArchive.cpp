@@ -0,0 +1,107 @@
+/**
+ * Bounded archive of good and diverse assignments for a Max-SAT instance
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "../include/EliteArchive.hpp"
+
+using namespace std;
+
+/**
+ * @brief Creates an empty archive
+ *
+ * @param n_vars Number of variables of the assignments
+ * @param capacity Maximum number of assignments kept
+ * @param min_distance Minimum Hamming distance between two members
+ */
+EliteArchive::EliteArchive(int n_vars, int capacity, int min_distance)
+    : n_vars(n_vars), capacity(capacity), min_distance(min_distance) {}
+
+/**
+ * @brief Offers an assignment to the archive
+ *
+ * @param assignment The assignment
+ * @param n_satisfied Its number of satisfied clauses
+ * @return true if the assignment was admitted
+ */
+bool EliteArchive::add(const vector<bool> &assignment, int n_satisfied) {
+    pack(assignment, words);
+
+    // Find the closest member and the worst one
+    int closest = -1, closest_distance = n_vars + 1, worst = -1;
+    for (int i = 0; i < size(); i++) {
+        int d = distance(words, packed[i]);
+        if (d < closest_distance) {
+            closest = i;
+            closest_distance = d;
+        }
+        if (worst == -1 || fitness[i] < fitness[worst]) worst = i;
+    }
+
+    int slot;
+    if (closest_distance == 0) {
+        return false;
+    } else if (closest_distance < min_distance) {
+        // Too similar to a member: it can only take its place
+        if (n_satisfied <= fitness[closest]) return false;
+        slot = closest;
+    } else if (size() < capacity) {
+        slot = size();
+        solutions.emplace_back();
+        packed.emplace_back();
+        fitness.push_back(0);
+    } else {
+        if (n_satisfied <= fitness[worst]) return false;
+        slot = worst;
+    }
+
+    solutions[slot] = assignment;
+    packed[slot] = words;
+    fitness[slot] = n_satisfied;
+    return true;
+}
+
+/**
+ * @brief Hamming distance between two members
+ */
+int EliteArchive::distance(int i, int j) {
+    return distance(packed[i], packed[j]);
+}
+
+/**
+ * @brief Index of the member with the most satisfied clauses, or -1 if the
+ * archive is empty
+ */
+int EliteArchive::best() {
+    int best = -1;
+    for (int i = 0; i < size(); i++)
+        if (best == -1 || fitness[i] > fitness[best]) best = i;
+    return best;
+}
+
+int EliteArchive::size() {
+    return solutions.size();
+}
+
+/**
+ * @brief Packs an assignment in 64-bit words, variable i being bit i % 64 of
+ * word i / 64
+ *
+ * @param assignment The assignment
+ * @param words [out] The packed assignment
+ */
+void EliteArchive::pack(const vector<bool> &assignment, vector<uint64_t> &words) {
+    words.assign((assignment.size() + 63) / 64, 0);
+    for (size_t i = 0; i < assignment.size(); i++)
+        if (assignment[i]) words[i>>6] |= (uint64_t) 1 << (i & 63);
+}
+
+int EliteArchive::distance(const vector<uint64_t> &a, const vector<uint64_t> &b) {
+    int d = 0;
+    for (size_t i = 0; i < a.size(); i++) d += __builtin_popcountll(a[i] ^ b[i]);
+    return d;
+}
@@ -18,170 +18,83 @@ using namespace std;
  * 
  * @param instance The SAT instance
  * @param seed The seed for the random number generator
+ * @param construction The method that builds the initial assignment, see
+ * GreedyConstruction
  */
-GLSSolver::GLSSolver(const SATInstance &instance, uint seed)
-    : MaxSATSolver(instance), seed(seed), penalty(instance.n_clauses, 0) {
-    // Initialize the optimal assignment with random values
+GLSSolver::GLSSolver(const SATInstance &instance, uint seed, int construction)
+    : MaxSATSolver(instance),
+      seed(seed),
+      construction(construction),
+      penalty(instance.n_clauses, 0),
+      evaluator(instance) {
+    // Initialize the optimal assignment
     srand(seed);
-    for (int i = 0; i < instance.n_vars; i++)
-        optimal_assignment.push_back(rand() & 1);
+    optimal_assignment = GreedyConstruction(instance).construct(construction);
 }
 
 /**
- * @brief Solves the instance using local search, taking as a neighborhood the
- * set of assignments that differ from the current one by flipping a single
- * variable
+ * @brief Solves the instance using guided local search: a local search on the
+ * objective augmented with clause penalties, taking as a neighborhood the set
+ * of assignments that differ from the current one by flipping a single
+ * variable; at each local optimum the unsatisfied clauses with maximum utility
+ * are penalized
  */
 void GLSSolver::solve() {
-    // Compute the initial number of satisfied clauses
-    int internal_optimal_n_satisfied;
-    vector<bool> internal_optimal_assignment = optimal_assignment;
+    compute_upper_bound();
 
-    while (trials < MAX_TRIALS) {
-        // Local search algorithm
-        int i = 0;
-        int current_n_satisfied = compute_n_satisfied(internal_optimal_assignment);
-        internal_optimal_n_satisfied = current_n_satisfied - (
-            param * penalty_sum(internal_optimal_assignment)
-        );
-
-        while (i < instance.n_vars) {
-            vector<bool> assignment = internal_optimal_assignment;
-
-            for (i = 0; i < instance.n_vars; i++) {
-                // Flip a variable and evaluate the new assignment
-                assignment[i] = !assignment[i];
-
-                pair<int, int> new_n_satisfied = evaluate_guided_flip(
-                    assignment, i, current_n_satisfied
-                );
-                if (new_n_satisfied.first > internal_optimal_n_satisfied) {
-                    internal_optimal_n_satisfied = new_n_satisfied.first;
-                    internal_optimal_assignment = assignment;
-                    current_n_satisfied = new_n_satisfied.second;
-                    break;
-                }
-
-                // Undo the flip
-                assignment[i] = !assignment[i];
-            }
-
-            optimal_found = instance.n_clauses == internal_optimal_n_satisfied;
-            if (optimal_found) break;
-        }
+    evaluator.reset(optimal_assignment);
+    optimal_n_satisfied = evaluator.n_satisfied;
 
-        // Update the overall optimal assignment if the internal optimal is better
-        if (current_n_satisfied > optimal_n_satisfied) {
-            optimal_assignment = internal_optimal_assignment;
-            optimal_n_satisfied = current_n_satisfied;
-        }
+    while (trials < MAX_TRIALS) {
+        descend();
 
+        optimal_found = optimal_n_satisfied >= upper_bound;
         if (optimal_found) break;
 
-        // Calculate the utility of each clause
-        priority_queue<pair<double, int>> utility;
-        for (int i = 0; i < instance.n_clauses; i++) {
-            bool i_s = indicator(internal_optimal_assignment, i);
-            double util = i_s / (double) (1 + penalty[i]);
-            utility.push(make_pair(util, i));
-        }
-
-        // For each clause with maximum utility, augment the penalty
-        pair<double, int> max_utility = utility.top();
-        do {
-            int index = utility.top().second;
-            penalty[index]++;
-            utility.pop();
-        } while (utility.size() && utility.top().first == max_utility.first);
-
+        penalize();
         trials++;
     }
 }
 
 /**
- * @brief Evaluates the given assignment
- * 
- * @param assignment The assignment to be evaluated
- * @param flipped_var The variable that was flipped to obtain the assignment
- * @param current_n_satisfied The number of satisfied clauses of the current assignment
- * @return int The new number of satisfied clauses of the assignment
+ * @brief Flips variables that improve the augmented objective until there is
+ * none left, keeping the best assignment on the original objective
  */
-pair<int, int> GLSSolver::evaluate_guided_flip(
-    vector<bool> &assignment,
-    int flipped_var,
-    int current_n_satisfied
-) {
-    int new_n_satisfied = current_n_satisfied;
-
-    // Scan the clauses affected by the flipped variable
-    for (auto i : affected_clauses[flipped_var]) {
-
-        bool already_satisfied = false;
-        int flipped_literal = -1;
-
-        for (auto literal : instance.clauses[i]) {
-            if (literal>>1 == flipped_var) {
-                if (flipped_literal == -1) flipped_literal = literal;
-                else if (flipped_literal != literal) {
-                    // Edge case: the clause contains p v -p
-                    already_satisfied = true;
-                    break;
-                }
-                continue;
-            }
-
-            // Check if the clause was already satisfied regardless of the flip
-            already_satisfied = instance.is_literal_true(literal, assignment);
-            if (already_satisfied) break;
-        }
-
-        // If the clause was not already satisfied, check how the flip affects
-        if (!already_satisfied) {
-            if (instance.is_literal_true(flipped_literal, assignment)) 
-                new_n_satisfied++;
-            else
-                new_n_satisfied--;
+void GLSSolver::descend() {
+    evaluator.update_good_vars();
+    while (evaluator.good_vars.size()) {
+        evaluator.flip(evaluator.good_vars[rand() % evaluator.good_vars.size()]);
+        evaluator.update_good_vars();
+
+        if (evaluator.n_satisfied > optimal_n_satisfied) {
+            optimal_n_satisfied = evaluator.n_satisfied;
+            optimal_assignment = evaluator.assignment;
+            if (optimal_n_satisfied >= upper_bound) return;
         }
     }
-
-    return make_pair(
-        new_n_satisfied - param * penalty_sum(assignment),
-        new_n_satisfied
-    );
 }
 
 /**
- * @brief Indicate if the clause i is violated by the assignment
- *        true if violated | false otherwise
- * 
- * @param assignment The assignment to be evaluated
- * @param i The clause to be evaluated
+ * @brief Augments the penalty of the unsatisfied clauses with maximum utility
+ * 1 / (1 + penalty); satisfied clauses have utility 0, so only the unsatisfied
+ * ones are scanned
  */
-bool GLSSolver::indicator(vector<bool> &assignment, int i) {
-    // Scans every literal in the clause to see if it is violated
-    for (int literal : instance.clauses[i])
-        if (instance.is_literal_true(literal, assignment))
-            return false;
-
-    return true;
-}
-
-int GLSSolver::penalty_sum(vector<bool> &assignment) {
-    // Compute the new number of satisfied_clauses, skipping the first iteration
-    int sum = 0;
-    if (trials != 0) {
-        for (int i = 0; i < instance.n_clauses; i++) {
-            bool i_s = indicator(assignment, i);
-            sum += i_s * penalty[i];
-        }
+void GLSSolver::penalize() {
+    int min_penalty = -1;
+    for (int i : evaluator.unsat_clauses)
+        if (min_penalty == -1 || penalty[i] < min_penalty) min_penalty = penalty[i];
+
+    for (int i : evaluator.unsat_clauses) {
+        if (penalty[i] != min_penalty) continue;
+        penalty[i]++;
+        evaluator.add_weight(i, param);
     }
-
-    return sum;
 }
 
 void GLSSolver::print_solution() {
     cout << "c Guided Local Search Solver" << endl;
     cout << "c MAX_TRIALS = " << MAX_TRIALS << endl;
+    cout << "c trials = " << trials << endl;
     cout << "c seed = " << seed << endl;
     MaxSATSolver::print_solution();
 }
\ No newline at end of file
@@ -4,8 +4,12 @@
  * Copyright (C) 2023 Christopher Gómez, Ka Fung
  */
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <numeric>
 #include <omp.h>
+#include <optional>
 
 #include "../include/SATInstance.hpp"
 #include "../include/GeneticAlgorithmSolver.hpp"
@@ -19,6 +23,8 @@
  * @param tournament_size Size of the tournament
  * @param mutation_percent Percentage of mutation of each child
  * @param seed The seed for the random number generator
+ * @param construction The method that builds the initial assignment, see
+ * GreedyConstruction
  * @return GeneticAlgorithmSolver:: 
  */
 GeneticAlgorithmSolver::GeneticAlgorithmSolver(
@@ -28,128 +34,502 @@ GeneticAlgorithmSolver::GeneticAlgorithmSolver(
     int mutation_probability,
     int mutation_percent,
     int elite_percent,
-    uint seed
+    uint seed,
+    int construction
 ) : MaxSATSolver(instance),
     seed(seed),
+    construction(construction),
     population_size(population_size),
     tournament_size(tournament_size),
     mutation_probability(mutation_probability),
     mutation_percent(mutation_percent),
-    elite_percent(elite_percent)
+    elite_percent(elite_percent),
+    diversity(
+        instance.n_vars,
+        DIVERSITY_THRESHOLD + 2 * mutation_probability * mutation_percent / 10000.0
+    ),
+    selection_operators(3),
+    crossover_operators(2),
+    mutation_operators(2),
+    archive(
+        instance.n_vars,
+        ARCHIVE_SIZE,
+        max(1, (int) (instance.n_vars * ARCHIVE_DISTANCE_FRACTION))
+    )
 {
-    // Initialize the population with random solutions
+    // Initialize the population
     srand(seed);
 
-    // Generate population_size random solutions
+    // Generate population_size solutions, each one visiting the variables in
+    // a different order
+    GreedyConstruction greedy(instance);
     population = vector<vector<bool>>(population_size);
     fitness = vector<int>(population_size);
     for (int i = 0; i < population_size; i++) {
-        vector<bool> solution;
-        for (int j = 0; j < instance.n_vars; j++) solution.push_back(rand() & 1);
+        vector<bool> solution = greedy.construct(construction);
         population[i] = solution;
         fitness[i] = compute_n_satisfied(solution);
     }
+
+    // Buffers reused by every generation; the next population is only
+    // allocated by the generational scheme
+    spare = vector<bool>(instance.n_vars);
+    elite_order = vector<int>(population_size);
+    clause_weight = vector<int>(instance.n_clauses, 1);
 }
 
 /**
  * @brief Solves the instance using genetic algorithm
  */
 void GeneticAlgorithmSolver::solve() {
-    int elite_individuals = population_size * elite_percent / 100;
-    uint iters = (population_size - elite_individuals) / 2 + 1;
+    compute_upper_bound();
+
+    // Relinks the members of the archive during the search, when enabled
+    optional<PathRelinkingSolver> relinker;
+    if (relink_interval > 0) {
+        relinker.emplace(instance, archive.capacity, archive.min_distance, seed);
+        relinker->set_upper_bound(upper_bound);
+    }
 
     while (generation < MAX_GENS) {
-        vector<vector<bool>> new_population = vector<vector<bool>>(population_size);
-        vector<int> new_fitness = vector<int>(population_size);
-
-        // Fixed sized scheduling
-        #pragma omp parallel for num_threads(6)
-        for (uint i = 0; i < iters; i++) {
-            // Generate two parents
-            vector<bool> parent1 = tournament_selection();
-            vector<bool> parent2 = tournament_selection();
-
-            // Generate two children from the parents
-            vector<bool> child1, child2;
-            int child1_fitness, child2_fitness;
-            two_point_crossover(parent1, parent2, child1, child2);
-
-            // Mutate the children with a given probability
-            child1_fitness = mutate(child1);
-            child2_fitness = mutate(child2);
-
-            // Add the children to the new population
-            new_population[i] = child1;
-            new_population[i + iters] = child2;
-            new_fitness[i] = child1_fitness;
-            new_fitness[i + iters] = child2_fitness;
-
-            // Update the optimal solution if a new one is found
-            #pragma omp critical
-            {
-                if (child1_fitness > optimal_n_satisfied) {
-                    optimal_n_satisfied = child1_fitness;
-                    optimal_assignment = child1;
-                }
+        evolve();
+        if (optimal_found || stagnated) break;
 
-                if (child2_fitness > optimal_n_satisfied) {
-                    optimal_n_satisfied = child2_fitness;
-                    optimal_assignment = child2;
-                }
+        if (relinker) {
+            intensify(*relinker);
+            if (optimal_found) break;
+        }
+
+        generation++;
+    }
+}
+
+/**
+ * @brief Replaces the population with the next generation, built by n_threads
+ * threads, each one with its own random generator. The incumbent is updated
+ * once the generation is complete, so the threads never synchronise
+ */
+void GeneticAlgorithmSolver::evolve() {
+    int elite_individuals = population_size * elite_percent / 100;
+    int n_offspring = population_size - elite_individuals;
+    int iters = (n_offspring + 1) / 2;
+
+    seed_generators(n_threads);
+    team_level = omp_get_level() + 1;
+
+    // Mean fitness of the parents, the reference of the selection operators
+    mean_fitness = 0;
+    for (uint i = 0; i < population_size; i++) mean_fitness += fitness[i];
+    mean_fitness /= population_size;
+
+    selection_operators.policy = operator_policy;
+    crossover_operators.policy = operator_policy;
+    mutation_operators.policy = operator_policy;
+
+    if (scheme == STEADY_STATE_SCHEME) {
+        evolve_steady_state(n_offspring);
+        monitor_diversity();
+        return;
+    }
+
+    if (next_population.size() != population_size) {
+        next_population = population;
+        next_fitness = fitness;
+    }
+
+    // Fixed sized scheduling
+    #pragma omp parallel for num_threads(n_threads)
+    for (int i = 0; i < iters; i++) {
+        // Generate two children in the next population; with an odd number
+        // of offspring the last child is discarded
+        vector<bool> &child1 = next_population[i];
+        vector<bool> &child2 = i + iters < n_offspring ?
+            next_population[i + iters] : spare;
+        int child1_fitness, child2_fitness;
+        breed(child1, child1_fitness, child2, child2_fitness);
+
+        next_fitness[i] = child1_fitness;
+        if (i + iters < n_offspring) next_fitness[i + iters] = child2_fitness;
+    }
+
+    // Add the best parents to the next population
+    select_elite(elite_individuals);
+
+    population.swap(next_population);
+    fitness.swap(next_fitness);
+
+    // Update the optimal solution if a new one is found
+    save_best();
+    update_operators();
+    if (fitness_mode == SAW_FITNESS && (generation + 1) % saw_interval == 0)
+        adapt_weights();
+    monitor_diversity();
+}
+
+/**
+ * @brief Measures the diversity of the population and, if it has collapsed,
+ * applies the configured response: reseeding part of the population or
+ * boosting the mutation, at most once every RESPONSE_INTERVAL generations, or
+ * stopping the search once it has stayed collapsed for STOP_GENERATIONS
+ */
+void GeneticAlgorithmSolver::monitor_diversity() {
+    diversity.measure(population);
+
+    if (cooldown && !--cooldown) mutation_boost = 1;
+    if (!diversity.collapsed()) return;
+
+    if (diversity_response == STOP_RESPONSE) {
+        stagnated = diversity.streak >= STOP_GENERATIONS;
+        return;
+    }
+
+    if (cooldown || diversity_response == NO_RESPONSE) return;
+    if (diversity_response == RESEED_RESPONSE) reseed();
+    else mutation_boost = MUTATION_BOOST;
+    cooldown = RESPONSE_INTERVAL;
+}
+
+/**
+ * @brief Replaces the worst RESEED_FRACTION of the population with new
+ * constructed individuals. The construction draws from the generator of the
+ * solver, so the islands of an island model do not share rand()
+ */
+void GeneticAlgorithmSolver::reseed() {
+    int n = population_size * RESEED_FRACTION;
+
+    iota(elite_order.begin(), elite_order.end(), 0);
+    partial_sort(
+        elite_order.begin(), elite_order.begin() + n, elite_order.end(),
+        [&](int a, int b) { return fitness[a] < fitness[b]; }
+    );
+
+    GreedyConstruction greedy(instance);
+    greedy.reseed(next_random());
+    for (int k = 0; k < n; k++) {
+        int i = elite_order[k];
+        population[i] = greedy.construct(construction);
+        set_fitness(i, evaluate(population[i]));
+    }
+}
+
+/**
+ * @brief Produces n_offspring children one pair at a time. Each child takes in
+ * place the position of the worst individual, or of the loser of a
+ * tournament, if it is better and not already in the population, so it can be
+ * selected as a parent right away
+ *
+ * @param n_offspring Number of children
+ */
+void GeneticAlgorithmSolver::evolve_steady_state(int n_offspring) {
+    if (bucket_index.empty()) index_population();
 
-                if (optimal_n_satisfied == instance.n_clauses)
-                    optimal_found = true;
+    for (int i = 0; i < n_offspring; i += 2) {
+        int children_fitness[2];
+        breed(children[0], children_fitness[0], children[1], children_fitness[1]);
+
+        for (int k = 0; k < 2; k++) {
+            int child_fitness = children_fitness[k];
+
+            int loser = replacement == TOURNAMENT_REPLACEMENT ?
+                tournament_loser() : worst_individual();
+            if (child_fitness <= fitness[loser] || is_duplicate(children[k], child_fitness))
+                continue;
+
+            // The replaced individual becomes the buffer of the next child
+            population[loser].swap(children[k]);
+            set_fitness(loser, child_fitness);
+
+            if (fitness_mode == SATISFIED_FITNESS && child_fitness > optimal_n_satisfied) {
+                optimal_n_satisfied = child_fitness;
+                optimal_assignment = population[loser];
             }
         }
+    }
 
-        if (optimal_found) break;
+    if (fitness_mode == SAW_FITNESS) save_best();
+    optimal_found = optimal_n_satisfied >= upper_bound;
+    update_operators();
+    if (fitness_mode == SAW_FITNESS && (generation + 1) % saw_interval == 0)
+        adapt_weights();
+}
+
+/**
+ * @brief Makes the individual with the best fitness the incumbent if it
+ * satisfies more clauses; with SAW fitness its number of satisfied clauses is
+ * computed, so the incumbent always counts unweighted clauses
+ */
+void GeneticAlgorithmSolver::save_best() {
+    int best = 0;
+    for (uint i = 1; i < population_size; i++)
+        if (fitness[i] > fitness[best]) best = i;
+
+    int n_satisfied = fitness_mode == SAW_FITNESS ?
+        compute_n_satisfied(population[best]) : fitness[best];
+    if (n_satisfied > optimal_n_satisfied) {
+        optimal_n_satisfied = n_satisfied;
+        optimal_assignment = population[best];
+    }
+    optimal_found = optimal_n_satisfied >= upper_bound;
+}
 
-        // Add the best parent to the new population
-        select_elite(new_population, new_fitness, elite_individuals);
+/**
+ * @brief Stepwise adaptation of weights: the clauses left unsatisfied by the
+ * best individual gain SAW_INCREMENT weight, and the fitness of every
+ * individual that satisfies them grows by the same amount, so no individual
+ * is evaluated again
+ */
+void GeneticAlgorithmSolver::adapt_weights() {
+    int best = 0;
+    for (uint i = 1; i < population_size; i++)
+        if (fitness[i] > fitness[best]) best = i;
+
+    adapted_clauses.clear();
+    for (int i = 0; i < instance.n_clauses; i++) {
+        bool satisfied = false;
+        for (int literal : instance.clauses[i]) {
+            satisfied = instance.is_literal_true(literal, population[best]);
+            if (satisfied) break;
+        }
+        if (satisfied) continue;
 
-        population = new_population;
-        fitness = new_fitness;
+        clause_weight[i] += SAW_INCREMENT;
+        adapted_clauses.push_back(i);
+    }
 
-        generation++;
+    for (uint j = 0; j < population_size; j++) {
+        int gain = 0;
+        for (int i : adapted_clauses) {
+            for (int literal : instance.clauses[i]) {
+                if (!instance.is_literal_true(literal, population[j])) continue;
+                gain += SAW_INCREMENT;
+                break;
+            }
+        }
+        if (gain) set_fitness(j, fitness[j] + gain);
     }
 }
 
 /**
- * @brief Selects the best solution from the population using tournament
- * selection
- * 
- * @return vector<bool> The best solution
+ * @brief Computes the fitness of an assignment from scratch: the total weight
+ * of the clauses it satisfies, which is the number of satisfied clauses
+ * unless the weights are adapted
+ *
+ * @param assignment The assignment to be evaluated
+ * @return int The fitness of the assignment
  */
-void GeneticAlgorithmSolver::select_elite(
-    vector<vector<bool>> &new_population,
-    vector<int> &new_fitness,
-    int n_elite
+int GeneticAlgorithmSolver::evaluate(const vector<bool> &assignment) {
+    int weight = 0;
+    for (int i = 0; i < instance.n_clauses; i++) {
+        for (int literal : instance.clauses[i]) {
+            if (!instance.is_literal_true(literal, assignment)) continue;
+            weight += clause_weight[i];
+            break;
+        }
+    }
+    return weight;
+}
+
+/**
+ * @brief Selects two parents, crosses them and mutates the children with the
+ * operators chosen by the operator selectors, which are given the improvement
+ * each operator produces and the time spent in it: for the selection, how
+ * much the best child beats the mean fitness; for the crossover, how much it
+ * beats the best parent; and for the mutation, how much the children improve
+ *
+ * @param child1 [out] The first child, already of size n_vars
+ * @param child1_fitness [out] Number of clauses satisfied by the first child
+ * @param child2 [out] The second child, already of size n_vars
+ * @param child2_fitness [out] Number of clauses satisfied by the second child
+ */
+void GeneticAlgorithmSolver::breed(
+    vector<bool> &child1,
+    int &child1_fitness,
+    vector<bool> &child2,
+    int &child2_fitness
 ) {
-    vector<vector<bool>> elite;
-    vector<int> elite_fitness;
+    bool adaptive = operator_policy != FIXED_OPERATORS;
+    int selection = TOURNAMENT_SELECTION;
+    int crossover = TWO_POINT_CROSSOVER;
+    int mutation = RANDOM_MUTATION;
+    if (adaptive) {
+        selection = selection_operators.select(next_random() / 4294967296.0);
+        crossover = crossover_operators.select(next_random() / 4294967296.0);
+        mutation = mutation_operators.select(next_random() / 4294967296.0);
+    }
 
-    for (int i = 0; i < n_elite; i++) {
-        int best_fitness = -1;
-        int best_index = -1;
+    // Only the adaptive policies use the time spent in each operator
+    double start = adaptive ? omp_get_wtime() : 0;
+    int parent1 = select_parent(selection);
+    int parent2 = select_parent(selection);
+
+    double selected = adaptive ? omp_get_wtime() : 0;
+    if (crossover == ONE_POINT_CROSSOVER)
+        cross(parent1, parent2, child1, child1_fitness, child2, child2_fitness);
+    else
+        two_point_crossover(parent1, parent2, child1, child1_fitness, child2, child2_fitness);
+
+    double crossed = adaptive ? omp_get_wtime() : 0;
+    int crossed_fitness = max(child1_fitness, child2_fitness);
+    int mutation_gain = 0;
+    for (int k = 0; k < 2; k++) {
+        vector<bool> &child = k ? child2 : child1;
+        int &child_fitness = k ? child2_fitness : child1_fitness;
+        int n_satisfied = mutation == GREEDY_MUTATION ?
+            mutateGreedy(child, child_fitness) : mutate(child, child_fitness);
+        mutation_gain += max(0, n_satisfied - child_fitness);
+        child_fitness = n_satisfied;
+    }
 
-        for (uint j = 0; j < fitness.size(); j++) {
-            if (fitness[j] > best_fitness) {
-                best_fitness = fitness[j];
-                best_index = j;
-            }
+    if (!adaptive) return;
+
+    double mutated = omp_get_wtime();
+    int best_parent = max(fitness[parent1], fitness[parent2]);
+    int best_child = max(child1_fitness, child2_fitness);
+    selection_operators.record(
+        selection, max(0.0, best_child - mean_fitness), selected - start
+    );
+    crossover_operators.record(
+        crossover, max(0, crossed_fitness - best_parent), crossed - selected
+    );
+    mutation_operators.record(mutation, mutation_gain, mutated - crossed);
+}
+
+/**
+ * @brief Gives the records of the generation to the operator selectors
+ */
+void GeneticAlgorithmSolver::update_operators() {
+    if (operator_policy == FIXED_OPERATORS) return;
+    selection_operators.update();
+    crossover_operators.update();
+    mutation_operators.update();
+}
+
+/**
+ * @brief Groups the individuals in buckets by fitness, so that the worst one
+ * is found without scanning the population, and takes the best one as the
+ * incumbent
+ */
+void GeneticAlgorithmSolver::index_population() {
+    buckets = vector<vector<int>>(*max_element(fitness.begin(), fitness.end()) + 1);
+    bucket_index = vector<int>(population_size);
+    bottom_bucket = buckets.size() - 1;
+    children = vector<vector<bool>>(2, vector<bool>(instance.n_vars));
+
+    for (uint i = 0; i < population_size; i++) {
+        bucket_index[i] = buckets[fitness[i]].size();
+        buckets[fitness[i]].push_back(i);
+        bottom_bucket = min(bottom_bucket, fitness[i]);
+
+        if (fitness[i] > optimal_n_satisfied) {
+            optimal_n_satisfied = fitness[i];
+            optimal_assignment = population[i];
         }
+    }
+}
+
+/**
+ * @brief Changes the fitness of an individual, moving it to its new bucket if
+ * the population is indexed
+ *
+ * @param i The individual
+ * @param value Its new number of satisfied clauses
+ */
+void GeneticAlgorithmSolver::set_fitness(int i, int value) {
+    if (!bucket_index.empty()) {
+        vector<int> &bucket = buckets[fitness[i]];
+        int last = bucket.back();
+        bucket[bucket_index[i]] = last;
+        bucket_index[last] = bucket_index[i];
+        bucket.pop_back();
+
+        // Adapted weights can take the fitness past the last bucket
+        if (value >= (int) buckets.size()) buckets.resize(value + 1);
+        bucket_index[i] = buckets[value].size();
+        buckets[value].push_back(i);
+        bottom_bucket = min(bottom_bucket, value);
+    }
+
+    fitness[i] = value;
+}
+
+/**
+ * @brief Checks if an individual is already in the population; only the ones
+ * with the same fitness, in the same bucket, can be equal to it
+ *
+ * @param solution The individual
+ * @param n_satisfied Its number of satisfied clauses
+ * @return bool True if an equal individual is in the population
+ */
+bool GeneticAlgorithmSolver::is_duplicate(const vector<bool> &solution, int n_satisfied) {
+    if (n_satisfied >= (int) buckets.size()) return false;
+    for (int i : buckets[n_satisfied])
+        if (population[i] == solution) return true;
+    return false;
+}
+
+/**
+ * @brief Individual with the lowest fitness, the last one of the lowest
+ * nonempty bucket
+ *
+ * @return int The index of the worst individual
+ */
+int GeneticAlgorithmSolver::worst_individual() {
+    while (buckets[bottom_bucket].empty()) bottom_bucket++;
+    return buckets[bottom_bucket].back();
+}
+
+/**
+ * @brief Offers the population to the elite archive and, every relink_interval
+ * generations, relinks pairs of its members; the best member then takes the
+ * place of the worst individual
+ *
+ * @param relinker The path relinking solver
+ */
+void GeneticAlgorithmSolver::intensify(PathRelinkingSolver &relinker) {
+    // The archive compares numbers of satisfied clauses; with SAW fitness
+    // they have to be computed, so the population is only offered when it
+    // is relinked
+    bool weighted = fitness_mode == SAW_FITNESS;
+    if (weighted && (generation + 1) % relink_interval) return;
+    for (uint i = 0; i < population_size; i++)
+        archive.add(population[i], weighted ? compute_n_satisfied(population[i]) : fitness[i]);
+    if ((generation + 1) % relink_interval) return;
+
+    relinker.intensify(archive, RELINK_PAIRS);
+    if (relinker.optimal_n_satisfied > optimal_n_satisfied) {
+        optimal_n_satisfied = relinker.optimal_n_satisfied;
+        optimal_assignment = relinker.optimal_assignment;
+    }
+    optimal_found = optimal_n_satisfied >= upper_bound;
 
-        elite.push_back(population[best_index]);
-        elite_fitness.push_back(best_fitness);
+    int best = archive.best(), worst = 0;
+    for (uint i = 1; i < population_size; i++)
+        if (fitness[i] < fitness[worst]) worst = i;
 
-        population.erase(population.begin() + best_index);
-        fitness.erase(fitness.begin() + best_index);
+    int best_fitness = weighted ? evaluate(archive.solutions[best]) : archive.fitness[best];
+    if (best_fitness > fitness[worst]) {
+        population[worst] = archive.solutions[best];
+        set_fitness(worst, best_fitness);
     }
+}
 
-    int base_index = new_population.size() - n_elite;
+/**
+ * @brief Copies the n_elite best individuals of the population to the end of
+ * the next population
+ *
+ * @param n_elite Number of elite individuals
+ */
+void GeneticAlgorithmSolver::select_elite(int n_elite) {
+    iota(elite_order.begin(), elite_order.end(), 0);
+    partial_sort(
+        elite_order.begin(), elite_order.begin() + n_elite, elite_order.end(),
+        [&](int a, int b) { return fitness[a] > fitness[b]; }
+    );
+
+    int base_index = population_size - n_elite;
     for (int i = 0; i < n_elite; i++) {
-        new_population[base_index + i] = elite[i];
-        new_fitness[base_index + i] = elite_fitness[i];
+        next_population[base_index + i] = population[elite_order[i]];
+        next_fitness[base_index + i] = fitness[elite_order[i]];
     }
 }
 
@@ -192,9 +572,9 @@ int GeneticAlgorithmSolver::eval_function(
         // If the clause was not already satisfied, check how the flip affects
         if (!already_satisfied) {
             if (instance.is_literal_true(flipped_literal, assignment)) 
-                new_n_satisfied++;
+                new_n_satisfied += clause_weight[i];
             else
-                new_n_satisfied--;
+                new_n_satisfied -= clause_weight[i];
         }
     }
 
@@ -202,81 +582,145 @@ int GeneticAlgorithmSolver::eval_function(
 }
 
 /**
- * @brief Cross two solutions
+ * @brief Cross two solutions at a random point
  *
- * @param parent1 The first solution
- * @param parent2 The second solution
- * @param child1 [out] The first child
- * @param child2 [out] The second child
+ * @param parent1 Index of the first parent
+ * @param parent2 Index of the second parent
+ * @param child1 [out] The first child, already of size n_vars
+ * @param child1_fitness [out] Number of clauses satisfied by the first child
+ * @param child2 [out] The second child, already of size n_vars
+ * @param child2_fitness [out] Number of clauses satisfied by the second child
  */
 void GeneticAlgorithmSolver::cross(
-    const vector<bool> &parent1,
-    const vector<bool> &parent2,
+    int parent1,
+    int parent2,
     vector<bool> &child1,
-    vector<bool> &child2
+    int &child1_fitness,
+    vector<bool> &child2,
+    int &child2_fitness
 ) {
     // Choose a random point to cross
-    int cross_point = rand() % instance.n_vars;
+    int cross_point = next_random() % instance.n_vars;
 
     // First children gets the first part of the first parent and the second
     // part of the second parent; and viceversa for the second child
-    for (int i = 0; i < cross_point; i++) {
-        child1.push_back(parent1[i]);
-        child2.push_back(parent2[i]);
-    }
-    for (int i = cross_point; i < instance.n_vars; i++) {
-        child1.push_back(parent2[i]);
-        child2.push_back(parent1[i]);
-    }
+    child1_fitness = recombine(parent1, parent2, 0, cross_point, child1);
+    child2_fitness = recombine(parent2, parent1, 0, cross_point, child2);
 }
 
+/**
+ * @brief Cross two solutions at two random points
+ *
+ * @param parent1 Index of the first parent
+ * @param parent2 Index of the second parent
+ * @param child1 [out] The first child, already of size n_vars
+ * @param child1_fitness [out] Number of clauses satisfied by the first child
+ * @param child2 [out] The second child, already of size n_vars
+ * @param child2_fitness [out] Number of clauses satisfied by the second child
+ */
 void GeneticAlgorithmSolver::two_point_crossover(
-    const vector<bool> &parent1,
-    const vector<bool> &parent2,
+    int parent1,
+    int parent2,
     vector<bool> &child1,
-    vector<bool> &child2
+    int &child1_fitness,
+    vector<bool> &child2,
+    int &child2_fitness
 ) { 
     // Choose two random points to cross
-    int cross_point1 = rand() % instance.n_vars;
-    int cross_point2 = rand() % instance.n_vars;
+    int cross_point1 = next_random() % instance.n_vars;
+    int cross_point2 = next_random() % instance.n_vars;
     if (cross_point1 > cross_point2) swap(cross_point1, cross_point2);
 
-    // First children gets the first part of the first parent and the second
-    // part of the second parent; and viceversa for the second child
-    for (int i = 0; i < cross_point1; i++) {
-        child1.push_back(parent1[i]);
-        child2.push_back(parent2[i]);
-    }
-    for (int i = cross_point1; i < cross_point2; i++) {
-        child1.push_back(parent2[i]);
-        child2.push_back(parent1[i]);
+    // First children gets the middle part of the second parent and the rest
+    // of the first parent; and viceversa for the second child
+    child1_fitness = recombine(parent2, parent1, cross_point1, cross_point2, child1);
+    child2_fitness = recombine(parent1, parent2, cross_point1, cross_point2, child2);
+}
+
+/**
+ * @brief Builds the child that takes the values of the inner parent in
+ * [begin, end) and the values of the outer parent elsewhere. Its fitness is
+ * computed from the parent it differs less from, flipping one by one the
+ * variables where they differ, so the cost depends on the number of changed
+ * variables rather than on the number of clauses
+ *
+ * @param inner Index of the parent of the segment
+ * @param outer Index of the parent of the rest
+ * @param begin First variable of the segment
+ * @param end Variable after the segment
+ * @param child [out] The child, already of size n_vars
+ * @return int The number of clauses satisfied by the child
+ */
+int GeneticAlgorithmSolver::recombine(
+    int inner,
+    int outer,
+    int begin,
+    int end,
+    vector<bool> &child
+) {
+    const vector<bool> &inner_parent = population[inner];
+    const vector<bool> &outer_parent = population[outer];
+
+    // Differences between the parents inside and outside the segment
+    int n_inside = 0, n_outside = 0;
+    for (int i = 0; i < instance.n_vars; i++) {
+        if (inner_parent[i] == outer_parent[i]) continue;
+        if (begin <= i && i < end) n_inside++;
+        else n_outside++;
     }
-    for (int i = cross_point2; i < instance.n_vars; i++) {
-        child1.push_back(parent1[i]);
-        child2.push_back(parent2[i]);
+
+    // Start from the nearer parent and flip the variables that differ
+    int n_satisfied;
+    if (n_inside <= n_outside) {
+        child = outer_parent;
+        n_satisfied = fitness[outer];
+        for (int i = begin; i < end; i++) {
+            if (child[i] == inner_parent[i]) continue;
+            child[i] = inner_parent[i];
+            n_satisfied = eval_function(child, i, n_satisfied);
+        }
+    } else {
+        child = inner_parent;
+        n_satisfied = fitness[inner];
+        for (int i = 0; i < instance.n_vars; i++) {
+            if ((begin <= i && i < end) || child[i] == outer_parent[i]) continue;
+            child[i] = outer_parent[i];
+            n_satisfied = eval_function(child, i, n_satisfied);
+        }
     }
+
+    return n_satisfied;
 }
 
 /**
- * @brief Mutate a solution
+ * @brief Mutate a solution, updating its fitness after each flip
  *
  * @param solution The solution to mutate
+ * @param n_satisfied Number of clauses satisfied by the solution
+ * @return int The number of clauses satisfied by the mutated solution
  */
-int GeneticAlgorithmSolver::mutate(vector<bool> &solution) {
-    if (rand() % 100 < mutation_probability) {
+int GeneticAlgorithmSolver::mutate(vector<bool> &solution, int n_satisfied) {
+    if ((int) (next_random() % 100) < mutation_probability) {
         for (int i = 0; i < instance.n_vars; i++) {
-            if (rand() % 100 < mutation_percent)
+            if ((int) (next_random() % 100) < mutation_percent * mutation_boost) {
                 solution[i] = !solution[i];
+                n_satisfied = eval_function(solution, i, n_satisfied);
+            }
         }
     }
 
-    return compute_n_satisfied(solution);
+    return n_satisfied;
 }
 
-
-int GeneticAlgorithmSolver::mutateGreedy(vector<bool> &solution) {
-    int n_satisfied = compute_n_satisfied(solution);
-    if (rand() % 100 < mutation_probability) {
+/**
+ * @brief Flips the first variable that improves the solution, if any
+ *
+ * @param solution The solution to mutate
+ * @param n_satisfied Number of clauses satisfied by the solution
+ * @return int The number of clauses satisfied by the mutated solution
+ */
+int GeneticAlgorithmSolver::mutateGreedy(vector<bool> &solution, int n_satisfied) {
+    if ((int) (next_random() % 100) < mutation_probability) {
         for (int i = 0; i < instance.n_vars; i++) {
             // Flip a variable and evaluate the new solution
             solution[i] = !solution[i];
@@ -297,70 +741,112 @@ int GeneticAlgorithmSolver::mutateGreedy(vector<bool> &solution) {
 /**
  * @brief Tournament selection
  *
- * @return vector<bool> The selected solution
+ * @return int The index of the selected solution
  */
-vector<bool> GeneticAlgorithmSolver::tournament_selection() {
-    vector<bool> best_solution;
-    int best_fitness = -1;
+int GeneticAlgorithmSolver::tournament_selection() {
+    int best_index = -1;
 
     // Choose tournament_size random solutions and select the best one
     for (int i = 0; i < tournament_size; i++) {
-        int index = rand() % population_size;
-        if (fitness[index] > best_fitness) {
-            best_fitness = fitness[index];
-            best_solution = population[index];
-        }
+        int index = next_random() % population_size;
+        if (best_index == -1 || fitness[index] > fitness[best_index])
+            best_index = index;
+    }
+    return best_index;
+}
+
+/**
+ * @brief Selects a parent with the given operator
+ *
+ * @param op TOURNAMENT_SELECTION, ROULETTE_WHEEL_SELECTION or
+ * ELITIST_SELECTION
+ * @return int The index of the selected solution
+ */
+int GeneticAlgorithmSolver::select_parent(int op) {
+    if (op == ROULETTE_WHEEL_SELECTION) return roulette_wheel_selection();
+    if (op == ELITIST_SELECTION) return elitist_selection();
+    return tournament_selection();
+}
+
+/**
+ * @brief Tournament in which the worst solution wins, used to choose the
+ * individual replaced by a child
+ *
+ * @return int The index of the selected solution
+ */
+int GeneticAlgorithmSolver::tournament_loser() {
+    int worst_index = -1;
+    for (int i = 0; i < tournament_size; i++) {
+        int index = next_random() % population_size;
+        if (worst_index == -1 || fitness[index] < fitness[worst_index])
+            worst_index = index;
     }
-    return best_solution;
+    return worst_index;
 }
 
 /**
  * @brief Roulette Wheel Selection
  *
- * @return vector<bool> The selected solution
+ * @return int The index of the selected solution
  */
-vector<bool> GeneticAlgorithmSolver::roulette_wheel_selection() {
+int GeneticAlgorithmSolver::roulette_wheel_selection() {
     // Calculate the total fitness of the population
-    int total_fitness = 0;
+    long long total_fitness = 0;
     for (uint i = 0; i < population_size; i++) total_fitness += fitness[i];
 
-    // Calculate the probability of each solution
-    vector<double> probabilities;
-    for (uint i = 0; i < population_size; i++)
-        probabilities.push_back((double) fitness[i] / total_fitness);
-
     // Choose a random number between 0 and 1
-    double random = (double) rand() / RAND_MAX;
+    double random = next_random() / 4294967296.0;
 
-    // Choose the solution that corresponds to the random number
+    // Choose the solution whose probability interval contains the number
     double sum = 0;
     for (uint i = 0; i < population_size; i++) {
-        sum += probabilities[i];
+        sum += (double) fitness[i] / total_fitness;
         if (sum >= random)
-            return population[i];
+            return i;
     }
 
     // If the random number is 1, return the last solution
-    return population[population_size - 1];
+    return population_size - 1;
 }
 
 /**
  * @brief Elitist Selection
  *
- * @return vector<bool> The selected solution
+ * @return int The index of the best solution
  */
-vector<bool> GeneticAlgorithmSolver::elitist_selection() {
-    vector<bool> best_solution;
-    int best_fitness = -1;
+int GeneticAlgorithmSolver::elitist_selection() {
+    int best_index = 0;
+    for (uint i = 1; i < population_size; i++)
+        if (fitness[i] > fitness[best_index]) best_index = i;
+    return best_index;
+}
 
-    // Choose the best solution
-    for (uint i = 0; i < population_size; i++) {
-        if (fitness[i] > best_fitness) {
-            best_fitness = fitness[i];
-            best_solution = population[i];
-        }
-    }
-    return best_solution;
+/**
+ * @brief Seeds one generator per thread, unless they are already seeded
+ *
+ * @param n Number of threads
+ */
+void GeneticAlgorithmSolver::seed_generators(int n) {
+    if (random_state.size() >= (size_t) n * RANDOM_STRIDE) return;
+
+    random_state = vector<uint64_t>(n * RANDOM_STRIDE);
+    for (int t = 0; t < n; t++)
+        random_state[t * RANDOM_STRIDE] = seed * 2654435761ULL + (t + 1) * 0x9E3779B97F4A7C15ULL;
+}
+
+/**
+ * @brief xorshift64* generator of the calling thread, so that the threads do
+ * not contend for the state of rand(). Outside the team of evolve(), e.g. in
+ * the steady state scheme or in a thread of an island model, the first
+ * generator is used
+ */
+uint32_t GeneticAlgorithmSolver::next_random() {
+    int thread = omp_get_level() == team_level ? omp_get_thread_num() : 0;
+    uint64_t &state = random_state[thread * RANDOM_STRIDE];
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (state * 2685821657736338717ULL) >> 32;
 }
 
 void GeneticAlgorithmSolver::print_solution() {
@@ -371,6 +857,28 @@ void GeneticAlgorithmSolver::print_solution() {
     cout << "c mutation_probability = " << mutation_probability << endl;
     cout << "c mutation_percent = " << mutation_percent << endl;
     cout << "c elite_percent = " << elite_percent << endl;
+    cout << "c scheme = " << scheme << endl;
+    cout << "c operator_policy = " << operator_policy << endl;
+    cout << "c fitness_mode = " << fitness_mode << endl;
+    if (fitness_mode == SAW_FITNESS)
+        cout << "c saw_interval = " << saw_interval << endl;
+    if (operator_policy != FIXED_OPERATORS) {
+        const char *kinds[] = {"selection", "crossover", "mutation"};
+        OperatorSelector *selectors[] = {
+            &selection_operators, &crossover_operators, &mutation_operators
+        };
+        for (int k = 0; k < 3; k++) {
+            cout << "c " << kinds[k] << " operator uses =";
+            for (long long n : selectors[k]->n_uses) cout << " " << n;
+            cout << endl;
+        }
+    }
+    if (scheme == STEADY_STATE_SCHEME)
+        cout << "c replacement = " << replacement << endl;
+    cout << "c relink_interval = " << relink_interval << endl;
+    cout << "c n_threads = " << n_threads << endl;
+    cout << "c diversity_response = " << diversity_response << endl;
+    diversity.print_trace();
     cout << "c seed = " << seed << endl;
     MaxSATSolver::print_solution();
 }
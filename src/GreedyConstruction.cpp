@@ -0,0 +1,143 @@
+/**
+ * Greedy construction of initial assignments for a Max-SAT instance
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/GreedyConstruction.hpp"
+
+using namespace std;
+
+/**
+ * @brief Builds the occurrence lists of each variable
+ *
+ * @param instance The SAT instance
+ */
+GreedyConstruction::GreedyConstruction(const SATInstance &instance)
+    : n_vars(instance.n_vars),
+      n_clauses(instance.n_clauses),
+      clauses(instance.clauses),
+      occurrences(instance.n_vars)
+{
+    for (int i = 0; i < n_clauses; i++)
+        for (int literal : clauses[i])
+            occurrences[literal>>1].push_back(make_pair(i, literal));
+}
+
+/**
+ * @brief Gives the construction its own random generator, so that it no
+ * longer draws from rand()
+ *
+ * @param seed The seed
+ */
+void GreedyConstruction::reseed(uint64_t seed) {
+    random_state = seed * 2654435761ULL + 1;
+    if (!random_state) random_state = 1;
+}
+
+/**
+ * @brief Builds an assignment with the given method
+ *
+ * @param method RANDOM_CONSTRUCTION, JOHNSON_CONSTRUCTION or
+ * PROPAGATION_CONSTRUCTION
+ * @param shuffle If true, the variables are visited in random order and ties
+ * are broken at random, so that each call gives a different assignment
+ * @return vector<bool> The assignment
+ */
+vector<bool> GreedyConstruction::construct(int method, bool shuffle) {
+    vector<bool> assignment(n_vars);
+    if (method == RANDOM_CONSTRUCTION) {
+        for (int i = 0; i < n_vars; i++) assignment[i] = next_random() & 1;
+        return assignment;
+    }
+
+    bool propagate = method == PROPAGATION_CONSTRUCTION;
+
+    value = vector<int>(n_vars, -1);
+    satisfied = vector<bool>(n_clauses, false);
+    n_free = vector<int>(n_clauses);
+    units.clear();
+    for (int i = 0; i < n_clauses; i++) {
+        n_free[i] = clauses[i].size();
+        if (propagate && n_free[i] == 1) units.push_back(i);
+    }
+
+    vector<int> order(n_vars);
+    for (int i = 0; i < n_vars; i++) order[i] = i;
+    if (shuffle)
+        for (int i = n_vars - 1; i > 0; i--) swap(order[i], order[next_random() % (i + 1)]);
+
+    for (int var : order) {
+        // Satisfy the clauses with a single unassigned literal first
+        while (units.size()) {
+            int clause = units.back();
+            units.pop_back();
+            if (satisfied[clause] || n_free[clause] != 1) continue;
+
+            for (int literal : clauses[clause]) {
+                if (value[literal>>1] != -1) continue;
+                assign(literal>>1, !(literal & 1), propagate);
+                break;
+            }
+        }
+
+        if (value[var] == -1) assign(var, choose_value(var, shuffle), propagate);
+    }
+
+    for (int i = 0; i < n_vars; i++) assignment[i] = value[i];
+    return assignment;
+}
+
+/**
+ * @brief Johnson's rule: an unsatisfied clause with k unassigned literals is
+ * satisfied by a random completion with probability 1 - 2^-k, so the value
+ * whose literal has the largest sum of 2^-k over its clauses gives the largest
+ * expected number of satisfied clauses
+ *
+ * @param var The variable to be assigned
+ * @param shuffle If true, ties are broken at random
+ * @return bool The chosen value
+ */
+bool GreedyConstruction::choose_value(int var, bool shuffle) {
+    double weight[2] = {0, 0};
+    for (auto &occurrence : occurrences[var]) {
+        int i = occurrence.first;
+        if (!satisfied[i]) weight[occurrence.second & 1] += ldexp(1.0, -n_free[i]);
+    }
+
+    if (weight[0] == weight[1]) return shuffle ? next_random() & 1 : true;
+    return weight[0] > weight[1];
+}
+
+/**
+ * @brief Assigns a variable, updating the clauses it appears in
+ */
+void GreedyConstruction::assign(int var, bool val, bool propagate) {
+    value[var] = val;
+
+    for (auto &occurrence : occurrences[var]) {
+        int i = occurrence.first;
+        if (satisfied[i]) continue;
+
+        if ((occurrence.second & 1) != val) {
+            satisfied[i] = true;
+        } else {
+            n_free[i]--;
+            if (propagate && n_free[i] == 1) units.push_back(i);
+        }
+    }
+}
+
+uint32_t GreedyConstruction::next_random() {
+    if (!random_state) return rand();
+
+    random_state ^= random_state >> 12;
+    random_state ^= random_state << 25;
+    random_state ^= random_state >> 27;
+    return (random_state * 2685821657736338717ULL) >> 32;
+}
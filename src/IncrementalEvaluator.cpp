@@ -0,0 +1,235 @@
+/**
+ * Incremental evaluation of single variable flips for a Max-SAT instance
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/IncrementalEvaluator.hpp"
+
+using namespace std;
+
+/**
+ * @brief Normalizes the clauses of the instance and builds the occurrence
+ * lists of each variable
+ *
+ * @param instance The SAT instance
+ */
+IncrementalEvaluator::IncrementalEvaluator(const SATInstance &instance)
+    : n_vars(instance.n_vars),
+      n_clauses(instance.n_clauses),
+      clauses(instance.n_clauses),
+      tautology(instance.n_clauses, false),
+      occurrences(instance.n_vars),
+      n_true(instance.n_clauses, 0),
+      sat_var(instance.n_clauses, 0),
+      unsat_index(instance.n_clauses, -1),
+      weight(instance.n_clauses, 1),
+      score(instance.n_vars, 0),
+      is_touched(instance.n_vars, false),
+      good_index(instance.n_vars, -1)
+{
+    // Remove repeated literals; a clause with p v -p is always satisfied
+    vector<int> seen(2 * n_vars, -1);
+    for (int i = 0; i < n_clauses; i++) {
+        for (int literal : instance.clauses[i]) {
+            if (seen[literal ^ 1] == i) tautology[i] = true;
+            if (seen[literal] == i) continue;
+            seen[literal] = i;
+            clauses[i].push_back(literal);
+        }
+
+        if (tautology[i]) {
+            clauses[i].clear();
+            continue;
+        }
+
+        for (int literal : clauses[i])
+            occurrences[literal>>1].push_back(make_pair(i, literal));
+    }
+}
+
+/**
+ * @brief Recomputes every counter from scratch for the given assignment
+ *
+ * @param new_assignment The assignment to be evaluated
+ */
+void IncrementalEvaluator::reset(const vector<bool> &new_assignment) {
+    assignment = new_assignment;
+    n_satisfied = 0;
+    unsat_clauses.clear();
+    fill(score.begin(), score.end(), 0);
+
+    for (int i = 0; i < n_clauses; i++) {
+        unsat_index[i] = -1;
+        if (tautology[i]) {
+            n_satisfied++;
+            continue;
+        }
+
+        n_true[i] = 0;
+        sat_var[i] = 0;
+        for (int literal : clauses[i]) {
+            if ((literal & 1) != assignment[literal>>1]) {
+                n_true[i]++;
+                sat_var[i] ^= literal>>1;
+            }
+        }
+
+        if (n_true[i] > 0) n_satisfied++;
+        if (n_true[i] == 1) score[sat_var[i]] -= weight[i];
+
+        // Empty clauses can never be satisfied, so they are not listed
+        if (n_true[i] == 0 && clauses[i].size()) {
+            unsat_index[i] = unsat_clauses.size();
+            unsat_clauses.push_back(i);
+            for (int literal : clauses[i]) score[literal>>1] += weight[i];
+        }
+    }
+
+    clear_touched();
+
+    good_vars.clear();
+    for (int i = 0; i < n_vars; i++) {
+        good_index[i] = -1;
+        if (score[i] > 0) {
+            good_index[i] = good_vars.size();
+            good_vars.push_back(i);
+        }
+    }
+}
+
+/**
+ * @brief Flips a variable, updating only the clauses it appears in
+ *
+ * @param var The variable to be flipped
+ */
+void IncrementalEvaluator::flip(int var) {
+    bool value = !assignment[var];
+    assignment[var] = value;
+
+    for (auto &occurrence : occurrences[var]) {
+        int i = occurrence.first;
+        int w = weight[i];
+        bool now_true = (occurrence.second & 1) != value;
+
+        sat_var[i] ^= var;
+
+        if (now_true) {
+            n_true[i]++;
+            if (n_true[i] == 1) {
+                // Every variable loses its make, var now breaks the clause
+                for (int literal : clauses[i]) change_score(literal>>1, -w);
+                change_score(var, -w);
+                make_sat(i);
+            } else if (n_true[i] == 2) {
+                // The critical variable no longer breaks the clause
+                change_score(sat_var[i] ^ var, w);
+            }
+        } else {
+            n_true[i]--;
+            if (n_true[i] == 0) {
+                // var no longer breaks the clause, every variable makes it
+                for (int literal : clauses[i]) change_score(literal>>1, w);
+                change_score(var, w);
+                make_unsat(i);
+            } else if (n_true[i] == 1) {
+                // The only true literal left becomes critical
+                change_score(sat_var[i], -w);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Changes the weight of a clause, updating the affected scores
+ *
+ * @param clause The clause whose weight changes
+ * @param amount The amount added to the weight
+ */
+void IncrementalEvaluator::add_weight(int clause, int amount) {
+    weight[clause] += amount;
+
+    if (n_true[clause] == 0) {
+        for (int literal : clauses[clause]) change_score(literal>>1, amount);
+    } else if (n_true[clause] == 1) {
+        change_score(sat_var[clause], -amount);
+    }
+}
+
+/**
+ * @brief Sets every clause weight back to 1 and recomputes the scores
+ */
+void IncrementalEvaluator::reset_weights() {
+    fill(weight.begin(), weight.end(), 1);
+    reset(vector<bool>(assignment));
+}
+
+/**
+ * @brief Change in the number of satisfied clauses if a variable is flipped,
+ * regardless of the clause weights
+ *
+ * @param var The variable to be flipped
+ * @return int The number of clauses made minus the number of clauses broken
+ */
+int IncrementalEvaluator::delta(int var) {
+    int d = 0;
+    for (auto &occurrence : occurrences[var]) {
+        int i = occurrence.first;
+        if (n_true[i] == 0) d++;
+        else if (n_true[i] == 1 && sat_var[i] == var) d--;
+    }
+    return d;
+}
+
+void IncrementalEvaluator::clear_touched() {
+    for (int var : touched) is_touched[var] = false;
+    touched.clear();
+}
+
+/**
+ * @brief Updates the set of good variables with the ones whose score changed
+ */
+void IncrementalEvaluator::update_good_vars() {
+    for (int var : touched) {
+        bool good = score[var] > 0;
+        if (good && good_index[var] == -1) {
+            good_index[var] = good_vars.size();
+            good_vars.push_back(var);
+        } else if (!good && good_index[var] != -1) {
+            int last = good_vars.back();
+            good_vars[good_index[var]] = last;
+            good_index[last] = good_index[var];
+            good_vars.pop_back();
+            good_index[var] = -1;
+        }
+    }
+    clear_touched();
+}
+
+void IncrementalEvaluator::change_score(int var, int amount) {
+    score[var] += amount;
+    if (!is_touched[var]) {
+        is_touched[var] = true;
+        touched.push_back(var);
+    }
+}
+
+void IncrementalEvaluator::make_unsat(int clause) {
+    n_satisfied--;
+    unsat_index[clause] = unsat_clauses.size();
+    unsat_clauses.push_back(clause);
+}
+
+void IncrementalEvaluator::make_sat(int clause) {
+    n_satisfied++;
+
+    // Swap with the last unsatisfied clause and pop
+    int last = unsat_clauses.back();
+    unsat_clauses[unsat_index[clause]] = last;
+    unsat_index[last] = unsat_index[clause];
+    unsat_clauses.pop_back();
+    unsat_index[clause] = -1;
+}
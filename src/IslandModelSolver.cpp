@@ -0,0 +1,224 @@
+/**
+ * Implementation of a Max-SAT solver based on an island model of genetic
+ * algorithms
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <omp.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/IslandModelSolver.hpp"
+
+using namespace std;
+
+/**
+ * @brief Creates the islands, each one with its own subpopulation and seed,
+ * and their mailboxes
+ *
+ * @param instance The SAT instance
+ * @param n_islands Number of islands, each one evolved by a thread
+ * @param population_size The size of the population of each island
+ * @param tournament_size Size of the tournament
+ * @param mutation_probability Probability of mutating each child
+ * @param mutation_percent Percentage of mutation of each child
+ * @param elite_percent Percentage of the population kept as elite
+ * @param seed The seed for the random number generator
+ * @param construction The method that builds the initial assignments, see
+ * GreedyConstruction
+ */
+IslandModelSolver::IslandModelSolver(
+    const SATInstance &instance,
+    int n_islands,
+    int population_size,
+    int tournament_size,
+    int mutation_probability,
+    int mutation_percent,
+    int elite_percent,
+    uint seed,
+    int construction
+) : MaxSATSolver(instance),
+    seed(seed),
+    n_islands(n_islands),
+    n_sent(n_islands),
+    n_accepted(n_islands),
+    slot_state(n_islands * MAILBOX_SIZE),
+    slot_migrant(n_islands * MAILBOX_SIZE, vector<bool>(instance.n_vars)),
+    slot_fitness(n_islands * MAILBOX_SIZE),
+    incumbent(0),
+    stop(false)
+{
+    islands.reserve(n_islands);
+    for (int i = 0; i < n_islands; i++) {
+        islands.emplace_back(
+            instance, population_size, tournament_size, mutation_probability,
+            mutation_percent, elite_percent, seed + i, construction
+        );
+
+        // Each island is evolved by a single thread
+        islands[i].n_threads = 1;
+    }
+
+    for (auto &state : slot_state) state = SLOT_EMPTY;
+    srand(seed);
+}
+
+/**
+ * @brief Evolves every island in its own thread for MAX_GENS generations, or
+ * until one of them reaches the upper bound
+ */
+void IslandModelSolver::solve() {
+    compute_upper_bound();
+    for (auto &island : islands) island.set_upper_bound(upper_bound);
+
+    #pragma omp parallel for num_threads(n_islands) schedule(static, 1)
+    for (int i = 0; i < n_islands; i++) evolve(i);
+
+    optimal_found = optimal_n_satisfied >= upper_bound;
+}
+
+/**
+ * @brief Evolves an island, exchanging migrants every migration_interval
+ * generations and sharing its improvements with the incumbent
+ *
+ * @param i The island
+ */
+void IslandModelSolver::evolve(int i) {
+    GeneticAlgorithmSolver &island = islands[i];
+    uint random_seed = seed + i;
+
+    while (
+        island.generation < MAX_GENS && !island.stagnated &&
+        !stop.load(memory_order_relaxed)
+    ) {
+        island.evolve();
+        share(i);
+        island.generation++;
+
+        if (n_islands < 2 || island.generation % migration_interval) continue;
+
+        // Send the best individuals to the next island of the ring or to a
+        // random one, and take in the ones received since the last migration
+        int target = (i + 1) % n_islands;
+        if (topology == RANDOM_TOPOLOGY)
+            target = (i + 1 + rand_r(&random_seed) % (n_islands - 1)) % n_islands;
+
+        emigrate(i, target);
+        immigrate(i);
+    }
+}
+
+/**
+ * @brief Copies the n_migrants best individuals of an island to free slots of
+ * the mailbox of the target island. A slot is claimed by switching it from
+ * empty to writing, so several islands can post to the same mailbox; migrants
+ * that find the mailbox full are dropped
+ *
+ * @param i The island that sends the migrants
+ * @param target The island that receives them
+ */
+void IslandModelSolver::emigrate(int i, int target) {
+    GeneticAlgorithmSolver &island = islands[i];
+    int n = min(n_migrants, (int) island.population_size);
+
+    vector<int> &order = island.elite_order;
+    iota(order.begin(), order.end(), 0);
+    partial_sort(
+        order.begin(), order.begin() + n, order.end(),
+        [&](int a, int b) { return island.fitness[a] > island.fitness[b]; }
+    );
+
+    int slot = target * MAILBOX_SIZE;
+    for (int k = 0; k < n; k++) {
+        for (; slot < (target + 1) * MAILBOX_SIZE; slot++) {
+            int expected = SLOT_EMPTY;
+            if (slot_state[slot].compare_exchange_strong(
+                expected, SLOT_WRITING, memory_order_acquire
+            )) break;
+        }
+        if (slot == (target + 1) * MAILBOX_SIZE) return;
+
+        slot_migrant[slot] = island.population[order[k]];
+        slot_fitness[slot] = island.fitness[order[k]];
+        slot_state[slot].store(SLOT_FULL, memory_order_release);
+        n_sent[i]++;
+    }
+}
+
+/**
+ * @brief Empties the mailbox of an island; each migrant replaces the worst
+ * individual if it is better
+ *
+ * @param i The island
+ */
+void IslandModelSolver::immigrate(int i) {
+    GeneticAlgorithmSolver &island = islands[i];
+
+    for (int slot = i * MAILBOX_SIZE; slot < (i + 1) * MAILBOX_SIZE; slot++) {
+        if (slot_state[slot].load(memory_order_acquire) != SLOT_FULL) continue;
+
+        int worst = 0;
+        for (uint j = 1; j < island.population_size; j++)
+            if (island.fitness[j] < island.fitness[worst]) worst = j;
+
+        // Weights adapted by the sender do not hold on this island
+        int migrant_fitness = island.fitness_mode == SAW_FITNESS ?
+            island.evaluate(slot_migrant[slot]) : slot_fitness[slot];
+
+        if (migrant_fitness > island.fitness[worst]) {
+            island.population[worst] = slot_migrant[slot];
+            island.set_fitness(worst, migrant_fitness);
+            n_accepted[i]++;
+        }
+
+        slot_state[slot].store(SLOT_EMPTY, memory_order_release);
+    }
+}
+
+/**
+ * @brief Makes the best assignment of an island the incumbent if it is better.
+ * The lock is only taken when the island beats the incumbent, and the islands
+ * stop once it reaches the upper bound
+ *
+ * @param i The island
+ */
+void IslandModelSolver::share(int i) {
+    GeneticAlgorithmSolver &island = islands[i];
+    if (island.optimal_n_satisfied <= incumbent.load(memory_order_relaxed)) return;
+
+    #pragma omp critical(island_incumbent)
+    {
+        if (island.optimal_n_satisfied > optimal_n_satisfied) {
+            optimal_n_satisfied = island.optimal_n_satisfied;
+            optimal_assignment = island.optimal_assignment;
+            incumbent.store(optimal_n_satisfied, memory_order_relaxed);
+        }
+    }
+
+    if (island.optimal_found) stop.store(true, memory_order_relaxed);
+}
+
+void IslandModelSolver::print_solution() {
+    int sent = accumulate(n_sent.begin(), n_sent.end(), 0);
+    int accepted = accumulate(n_accepted.begin(), n_accepted.end(), 0);
+
+    cout << "c Island Model Solver" << endl;
+    cout << "c MAX_GENS = " << MAX_GENS << endl;
+    cout << "c n_islands = " << n_islands << endl;
+    cout << "c population_size = " << islands[0].population_size << endl;
+    cout << "c tournament_size = " << islands[0].tournament_size << endl;
+    cout << "c mutation_probability = " << islands[0].mutation_probability << endl;
+    cout << "c mutation_percent = " << islands[0].mutation_percent << endl;
+    cout << "c elite_percent = " << islands[0].elite_percent << endl;
+    cout << "c topology = " << topology << endl;
+    cout << "c migration_interval = " << migration_interval << endl;
+    cout << "c n_migrants = " << n_migrants << endl;
+    cout << "c migrants sent = " << sent << ", accepted = " << accepted << endl;
+    cout << "c seed = " << seed << endl;
+    MaxSATSolver::print_solution();
+}
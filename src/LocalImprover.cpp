@@ -0,0 +1,231 @@
+/**
+ * Budgeted local improvement of an assignment for Max-SAT
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/LocalImprover.hpp"
+
+using namespace std;
+
+/**
+ * @param instance The SAT instance
+ * @param method FIRST_IMPROVEMENT, BEST_IMPROVEMENT, ANNEALING_IMPROVEMENT,
+ * TABU_IMPROVEMENT or WALKSAT_IMPROVEMENT
+ * @param seed The seed for the random number generator
+ */
+LocalImprover::LocalImprover(const SATInstance &instance, int method, uint64_t seed)
+    : method(method),
+      upper_bound(instance.n_clauses),
+      evaluator(instance),
+      tabu_until(instance.n_vars, 0),
+      random_state(seed * 2654435761ULL + 1)
+{
+}
+
+/**
+ * @brief Restarts the random generator
+ *
+ * @param seed The new seed
+ */
+void LocalImprover::reseed(uint64_t seed) {
+    random_state = seed * 2654435761ULL + 1;
+}
+
+/**
+ * @brief Improves an assignment in place
+ *
+ * @param assignment [in, out] The assignment
+ * @param budget Maximum number of steps
+ * @return int The number of clauses satisfied by the improved assignment
+ */
+int LocalImprover::improve(vector<bool> &assignment, int budget) {
+    evaluator.reset(assignment);
+    best_n_satisfied = evaluator.n_satisfied;
+    flip_log.clear();
+
+    int steps;
+    if (method == BEST_IMPROVEMENT) steps = best_improvement(budget);
+    else if (method == ANNEALING_IMPROVEMENT) steps = anneal(budget);
+    else if (method == TABU_IMPROVEMENT) steps = tabu(budget);
+    else if (method == WALKSAT_IMPROVEMENT) steps = walk(budget);
+    else steps = first_improvement(budget);
+
+    // Go back to the best assignment visited
+    for (int i = flip_log.size() - 1; i >= 0; i--) evaluator.flip(flip_log[i]);
+
+    assignment = evaluator.assignment;
+    n_calls++;
+    n_steps += steps;
+    return evaluator.n_satisfied;
+}
+
+/**
+ * @brief Flips the first variable that satisfies more clauses than it breaks,
+ * scanning again from the first variable after each flip, like
+ * LocalSearchSolver
+ */
+int LocalImprover::first_improvement(int budget) {
+    int steps = 0;
+    for (int var = 0; var < evaluator.n_vars && steps < budget && !done(); var++) {
+        if (evaluator.score[var] > 0) {
+            flip(var);
+            steps++;
+            var = -1;
+        }
+    }
+    return steps;
+}
+
+/**
+ * @brief Flips the variable with the best score while it is positive
+ */
+int LocalImprover::best_improvement(int budget) {
+    int steps = 0;
+    while (steps < budget && evaluator.good_vars.size() && !done()) {
+        int best = evaluator.good_vars[0];
+        for (int var : evaluator.good_vars)
+            if (evaluator.score[var] > evaluator.score[best]) best = var;
+
+        flip(best);
+        steps++;
+    }
+    return steps;
+}
+
+/**
+ * @brief Proposes flipping random variables, accepting the ones that break
+ * k more clauses than they make with probability exp(-k / T), where the
+ * temperature T decreases linearly to 0 over the budget
+ */
+int LocalImprover::anneal(int budget) {
+    int steps = 0;
+    for (; steps < budget && !done(); steps++) {
+        int var = ((uint64_t) next_random() * evaluator.n_vars) >> 32;
+        int delta = evaluator.score[var];
+
+        if (delta < 0) {
+            double t = temperature * (budget - steps) / budget;
+            if (next_random() / 4294967296.0 >= exp(delta / t)) continue;
+        }
+        flip(var);
+    }
+    return steps;
+}
+
+/**
+ * @brief Flips the non-tabu variable with the best positive score, or a tabu
+ * one if it leads to a new best assignment. At a local optimum, flips the
+ * non-tabu variable with the best score of a random unsatisfied clause. The
+ * clock first moves past the tenure of the previous call, so no variable
+ * starts tabu
+ */
+int LocalImprover::tabu(int budget) {
+    int steps = 0;
+    tabu_clock += tenure;
+    for (; steps < budget && !done(); steps++) {
+        long long now = tabu_clock++;
+        int best = -1;
+        for (int var : evaluator.good_vars) {
+            bool allowed = tabu_until[var] <= now ||
+                evaluator.n_satisfied + evaluator.score[var] > best_n_satisfied;
+            if (allowed && (best == -1 || evaluator.score[var] > evaluator.score[best]))
+                best = var;
+        }
+
+        if (best == -1) {
+            vector<int> &unsat = evaluator.unsat_clauses;
+            if (unsat.empty()) break;
+
+            vector<int> &clause = evaluator.clauses[unsat[next_random() % unsat.size()]];
+            for (int literal : clause) {
+                int var = literal>>1;
+                if (tabu_until[var] > now) continue;
+                if (best == -1 || evaluator.score[var] > evaluator.score[best]) best = var;
+            }
+            if (best == -1) best = clause[next_random() % clause.size()]>>1;
+        }
+
+        flip(best);
+        tabu_until[best] = now + tenure;
+    }
+    return steps;
+}
+
+/**
+ * @brief WalkSAT: picks a random unsatisfied clause and flips one of its
+ * variables that breaks no clause if there is one; otherwise, with
+ * probability noise a random variable of the clause, or else the one that
+ * breaks the fewest clauses
+ */
+int LocalImprover::walk(int budget) {
+    int steps = 0;
+    for (; steps < budget && !done(); steps++) {
+        vector<int> &unsat = evaluator.unsat_clauses;
+        if (unsat.empty()) break;
+
+        vector<int> &clause = evaluator.clauses[unsat[next_random() % unsat.size()]];
+        int best = -1, best_break = 0;
+        for (int literal : clause) {
+            int n_breaks = break_count(literal>>1);
+            if (best == -1 || n_breaks < best_break) {
+                best = literal>>1;
+                best_break = n_breaks;
+            }
+        }
+
+        if (best_break > 0 && next_random() / 4294967296.0 < noise)
+            best = clause[next_random() % clause.size()]>>1;
+        flip(best);
+    }
+    return steps;
+}
+
+/**
+ * @brief Flips a variable, keeping track of the best assignment visited
+ *
+ * @param var The variable
+ */
+void LocalImprover::flip(int var) {
+    evaluator.flip(var);
+    evaluator.update_good_vars();
+
+    if (evaluator.n_satisfied > best_n_satisfied) {
+        best_n_satisfied = evaluator.n_satisfied;
+        flip_log.clear();
+    } else {
+        flip_log.push_back(var);
+    }
+}
+
+/**
+ * @brief Number of clauses that flipping a variable would break
+ *
+ * @param var The variable
+ */
+int LocalImprover::break_count(int var) {
+    int n_breaks = 0;
+    for (auto &occurrence : evaluator.occurrences[var]) {
+        int i = occurrence.first;
+        n_breaks += evaluator.n_true[i] == 1 && evaluator.sat_var[i] == var;
+    }
+    return n_breaks;
+}
+
+/**
+ * @brief Checks if the best assignment visited reaches the upper bound
+ */
+bool LocalImprover::done() {
+    return best_n_satisfied >= upper_bound;
+}
+
+uint32_t LocalImprover::next_random() {
+    random_state ^= random_state >> 12;
+    random_state ^= random_state << 25;
+    random_state ^= random_state >> 27;
+    return (random_state * 2685821657736338717ULL) >> 32;
+}
@@ -18,13 +18,17 @@ using namespace std;
  * 
  * @param instance The SAT instance
  * @param seed The seed for the random number generator
+ * @param construction The method that builds the initial assignment, see
+ * GreedyConstruction
  */
-LocalSearchSolver::LocalSearchSolver(const SATInstance &instance, uint seed)
-    : MaxSATSolver(instance), seed(seed) {
-    // Initialize the optimal assignment with random values
+LocalSearchSolver::LocalSearchSolver(
+    const SATInstance &instance,
+    uint seed,
+    int construction
+) : MaxSATSolver(instance), seed(seed), construction(construction) {
+    // Initialize the optimal assignment
     srand(seed);
-    for (int i = 0; i < instance.n_vars; i++)
-        optimal_assignment.push_back(rand() & 1);
+    optimal_assignment = GreedyConstruction(instance).construct(construction);
 }
 
 /**
@@ -33,6 +37,7 @@ LocalSearchSolver::LocalSearchSolver(const SATInstance &instance, uint seed)
  * variable
  */
 void LocalSearchSolver::solve() {
+    compute_upper_bound();
     do_local_search(0);
 }
 
@@ -66,7 +71,7 @@ void LocalSearchSolver::do_local_search(int penalty_sum) {
             assignment[i] = !assignment[i];
         }
 
-        optimal_found = instance.n_clauses == optimal_n_satisfied;
+        optimal_found = optimal_n_satisfied >= upper_bound;
         if (optimal_found) break;
     }
 }
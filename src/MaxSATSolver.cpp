@@ -9,6 +9,7 @@
 
 #include "../include/MaxSATSolver.hpp"
 #include "../include/SATInstance.hpp"
+#include "../include/UpperBound.hpp"
 
 using namespace std;
 
@@ -17,10 +18,53 @@ MaxSATSolver::MaxSATSolver(const SATInstance &instance)
     optimal_found = false;
     optimal_n_satisfied = 0;
 
-    // For each clause, save for each variable the clauses it affects
-    for (int i = 0; i < instance.n_clauses; i++)
-        for (auto literal : instance.clauses[i])
-            affected_clauses[literal>>1].push_back(i);
+    // Empty clauses can never be satisfied
+    upper_bound = instance.n_clauses;
+    upper_bound_computed = false;
+
+    // For each clause, save for each variable the clauses it affects, once
+    // even if the variable appears several times in the clause
+    for (int i = 0; i < instance.n_clauses; i++) {
+        if (instance.clauses[i].empty()) upper_bound--;
+        for (auto literal : instance.clauses[i]) {
+            vector<int> &clauses = affected_clauses[literal>>1];
+            if (clauses.empty() || clauses.back() != i) clauses.push_back(i);
+        }
+    }
+}
+
+/**
+ * @brief Replaces the random starting assignment of the solver, e.g. by one
+ * built by an initializer, before calling solve()
+ *
+ * @param assignment The starting assignment
+ */
+void MaxSATSolver::set_initial_assignment(const vector<bool> &assignment) {
+    optimal_assignment = assignment;
+    optimal_n_satisfied = compute_n_satisfied(assignment);
+}
+
+/**
+ * @brief Computes the upper bound on the number of satisfiable clauses, only
+ * the first time it is called
+ */
+void MaxSATSolver::compute_upper_bound() {
+    if (upper_bound_computed) return;
+
+    UpperBound bound(instance);
+    upper_bound = bound.compute();
+    upper_bound_computed = true;
+}
+
+/**
+ * @brief Sets an upper bound already known, e.g. the one of a solver of the
+ * same instance, so that it is not computed again
+ *
+ * @param bound The maximum number of clauses that can be satisfied
+ */
+void MaxSATSolver::set_upper_bound(int bound) {
+    upper_bound = bound;
+    upper_bound_computed = true;
 }
 
 /**
@@ -4,13 +4,14 @@
  * Copyright (C) 2023 Christopher Gómez, Ka Fung
  */
 
+#include <algorithm>
 #include <iostream>
+#include <numeric>
 #include <omp.h>
+#include <optional>
 
 #include "../include/SATInstance.hpp"
-#include "../include/LocalSearchSolver.hpp"
 #include "../include/MemeticAlgorithmSolver.hpp"
-#include "../include/SimulatedAnnealingSolver.hpp"
 
 /**
  * @brief Generates an initial population for the instance to be solved, using
@@ -21,6 +22,8 @@
  * @param tournament_size Size of the tournament
  * @param mutation_percent Percentage of mutation of each child
  * @param seed The seed for the random number generator
+ * @param construction The method that builds the initial assignment, see
+ * GreedyConstruction
  * @return MemeticAlgorithmSolver:: 
  */
 MemeticAlgorithmSolver::MemeticAlgorithmSolver(
@@ -30,24 +33,37 @@ MemeticAlgorithmSolver::MemeticAlgorithmSolver(
     int mutation_probability,
     int mutation_percent,
     int elite_percent,
-    uint seed
+    uint seed,
+    int construction
 ) : MaxSATSolver(instance),
     seed(seed),
+    construction(construction),
     population_size(population_size),
     tournament_size(tournament_size),
     mutation_probability(mutation_probability),
     mutation_percent(mutation_percent),
-    elite_percent(elite_percent)
+    elite_percent(elite_percent),
+    diversity(
+        instance.n_vars,
+        DIVERSITY_THRESHOLD + 2 * mutation_probability * mutation_percent / 10000.0
+    ),
+    archive(
+        instance.n_vars,
+        ARCHIVE_SIZE,
+        max(1, (int) (instance.n_vars * ARCHIVE_DISTANCE_FRACTION))
+    ),
+    recombination_operators(3)
 {
-    // Initialize the population with random solutions
+    // Initialize the population
     srand(seed);
 
-    // Generate population_size random solutions
+    // Generate population_size solutions, each one visiting the variables in
+    // a different order
+    GreedyConstruction greedy(instance);
     population = vector<vector<bool>>(population_size);
     fitness = vector<int>(population_size);
     for (int i = 0; i < population_size; i++) {
-        vector<bool> solution;
-        for (int j = 0; j < instance.n_vars; j++) solution.push_back(rand() & 1);
+        vector<bool> solution = greedy.construct(construction);
         population[i] = solution;
         fitness[i] = compute_n_satisfied(solution);
     }
@@ -57,7 +73,22 @@ MemeticAlgorithmSolver::MemeticAlgorithmSolver(
  * @brief Solves the instance using Memetic algorithm
  */
 void MemeticAlgorithmSolver::solve() {
+    compute_upper_bound();
+
+    // Relinks the members of the archive during the search, when enabled
+    optional<PathRelinkingSolver> relinker;
+    if (relink_interval > 0) {
+        relinker.emplace(instance, archive.capacity, archive.min_distance, seed);
+        relinker->set_upper_bound(upper_bound);
+    }
+
     int elite_individuals = population_size * elite_percent / 100;
+    bool adaptive = operator_policy != FIXED_OPERATORS;
+    recombination_operators.policy = operator_policy;
+    if (clause_crossovers.empty() && (recombination == CLAUSE_RECOMBINATION || adaptive)) {
+        clause_crossovers.reserve(n_threads);
+        for (int t = 0; t < n_threads; t++) clause_crossovers.emplace_back(instance);
+    }
 
     // Take 10% of the population for recombinations
     int k = population_size * 0.05;
@@ -68,50 +99,80 @@ void MemeticAlgorithmSolver::solve() {
     // Number of reproduction iterations (considering the elite individuals)
     uint iters = (population_size - elite_individuals) / n_children + 1;
 
-    // Apply local search to initial population
-    for (uint i = 0; i < population_size; i++) {
-        LocalSearchSolver solver(instance);
-        solver.optimal_assignment = population[i];
-        solver.solve();
-        population[i] = solver.optimal_assignment;
-        fitness[i] = solver.optimal_n_satisfied;
+    if (improvers.empty()) {
+        improvers.reserve(n_threads);
+        for (int t = 0; t < n_threads; t++) improvers.emplace_back(instance, improver, seed + t);
+    }
+    for (auto &local : improvers) {
+        local.method = improver;
+        local.upper_bound = upper_bound;
     }
 
+    // Improve the initial population
+    pool.n_workers = n_threads;
+    pool.seed = seed;
+    pool.run(population_size, [&](int i, int worker) {
+        improvers[worker].reseed(pool.next_random(worker));
+        fitness[i] = improvers[worker].improve(population[i], flip_budget);
+    });
+
     while (generation < MAX_GENERATIONS) {
         vector<vector<bool>> new_population = vector<vector<bool>>(population_size);
         vector<int> new_fitness = vector<int>(population_size);
+        vector<int> crossed_fitness = vector<int>(population_size, -1);
 
-        // Fixed sized scheduling
-        #pragma omp parallel for num_threads(6)
-        for (uint i = 0; i < iters; i++) {
-            vector<vector<bool>> tournament_population = vector<vector<bool>>(k);
+        // Each task recombines a group of parents and improves its children;
+        // their length varies a lot, so they are balanced by work stealing
+        pool.run(iters, [&](int i, int worker) {
+            vector<int> tournament_population = vector<int>(k);
             
             // Select k random individuals from the population
-            for (int j = 0; j < k; j++) {
-                vector<bool> parent = tournament_selection();
-                tournament_population[j] = parent;
-            }
+            for (int j = 0; j < k; j++)
+                tournament_population[j] = tournament_selection(worker);
             
             // Generate n children from the parents
             vector<vector<bool>> children = vector<vector<bool>>(n_children);
             vector<int> children_fitness = vector<int>(n_children);
-            uniform_recombination(tournament_population, children);
+            int op = recombination;
+            if (adaptive)
+                op = recombination_operators.select(pool.next_random(worker) / 4294967296.0);
+
+            // Only the adaptive policies use the time spent in each task
+            double start = adaptive ? omp_get_wtime() : 0;
+            if (op == CLAUSE_RECOMBINATION)
+                clause_recombination(tournament_population, children, children_fitness, worker);
+            else if (op == SEGMENT_RECOMBINATION)
+                segment_recombination(tournament_population, children, children_fitness, worker);
+            else
+                uniform_recombination(tournament_population, children, children_fitness, worker);
 
             // Mutate each children with a given probability
             for (int j = 0; j < n_children; j++) 
-                children_fitness[j] = mutate(children[j]);
+                children_fitness[j] = mutate(children[j], children_fitness[j], worker);
 
 
-            // Apply local search to each children
+            // Improve each child within its budget
+            LocalImprover &local = improvers[worker];
+            local.reseed(pool.next_random(worker));
             for (int j = 0; j < n_children; j++) {
-                LocalSearchSolver solver(instance);
-
-                // Modifica que el optimal assigment inicial sea el hijo
-                solver.optimal_assignment = children[j];
+                crossed_fitness[i * n_children + j] = children_fitness[j];
+                int budget = child_budget(children_fitness[j]);
+                children_fitness[j] = local.improve(children[j], budget);
+            }
 
-                solver.solve();
-                children[j] = solver.optimal_assignment;
-                children_fitness[j] = solver.optimal_n_satisfied;
+            // Reward the recombination with the improvement of the best child
+            // over the best parent, per second spent on the children
+            if (adaptive) {
+                int best_parent = 0, best_child = 0;
+                for (int parent : tournament_population)
+                    best_parent = max(best_parent, fitness[parent]);
+                for (int j = 0; j < n_children; j++)
+                    best_child = max(best_child, children_fitness[j]);
+
+                recombination_operators.record(
+                    op, max(0, best_child - best_parent),
+                    omp_get_wtime() - start
+                );
             }
 
             // Add each children to the new population
@@ -130,12 +191,23 @@ void MemeticAlgorithmSolver::solve() {
                     }
                 }
 
-                if (optimal_n_satisfied == instance.n_clauses) 
+                if (optimal_n_satisfied >= upper_bound)
                     optimal_found = true;
             }
-        }
+        });
 
         if (optimal_found) break;
+        if (adaptive) recombination_operators.update();
+
+        // Range of the fitness of the children before improvement, for the
+        // budgets of the next generation
+        worst_child = upper_bound;
+        best_child = 0;
+        for (int f : crossed_fitness) {
+            if (f < 0) continue;
+            worst_child = min(worst_child, f);
+            best_child = max(best_child, f);
+        }
 
         // Add the best parent to the new population
         select_elite(new_population, new_fitness, elite_individuals);
@@ -143,10 +215,113 @@ void MemeticAlgorithmSolver::solve() {
         population = new_population;
         fitness = new_fitness;
 
+        if (relinker) {
+            intensify(*relinker);
+            if (optimal_found) break;
+        }
+
+        monitor_diversity();
+        if (stagnated) break;
+
         generation++;
     }
 }
 
+/**
+ * @brief Measures the diversity of the population and, if it has collapsed,
+ * applies the configured response: reseeding part of the population or
+ * boosting the mutation, at most once every RESPONSE_INTERVAL generations, or
+ * stopping the search once it has stayed collapsed for STOP_GENERATIONS
+ */
+void MemeticAlgorithmSolver::monitor_diversity() {
+    diversity.measure(population);
+
+    if (cooldown && !--cooldown) mutation_boost = 1;
+    if (!diversity.collapsed()) return;
+
+    if (diversity_response == STOP_RESPONSE) {
+        stagnated = diversity.streak >= STOP_GENERATIONS;
+        return;
+    }
+
+    if (cooldown || diversity_response == NO_RESPONSE) return;
+    if (diversity_response == RESEED_RESPONSE) reseed();
+    else mutation_boost = MUTATION_BOOST;
+    cooldown = RESPONSE_INTERVAL;
+}
+
+/**
+ * @brief Replaces the worst RESEED_FRACTION of the population with new
+ * constructed individuals, improved like the initial ones
+ */
+void MemeticAlgorithmSolver::reseed() {
+    int n = population_size * RESEED_FRACTION;
+
+    vector<int> order(population_size);
+    iota(order.begin(), order.end(), 0);
+    partial_sort(
+        order.begin(), order.begin() + n, order.end(),
+        [&](int a, int b) { return fitness[a] < fitness[b]; }
+    );
+
+    GreedyConstruction greedy(instance);
+    for (int k = 0; k < n; k++) {
+        int i = order[k];
+        population[i] = greedy.construct(construction);
+        fitness[i] = improvers[0].improve(population[i], flip_budget);
+
+        if (fitness[i] > optimal_n_satisfied) {
+            optimal_n_satisfied = fitness[i];
+            optimal_assignment = population[i];
+        }
+    }
+    optimal_found = optimal_n_satisfied >= upper_bound;
+}
+
+/**
+ * @brief Budget of local improvement of a child. With QUALITY_BUDGET, a child
+ * as good as the best child of the previous generation gets twice flip_budget
+ * and one as bad as the worst gets MIN_BUDGET_FRACTION of it
+ *
+ * @param child_fitness Number of clauses satisfied by the child
+ * @return int The maximum number of steps
+ */
+int MemeticAlgorithmSolver::child_budget(int child_fitness) {
+    if (budget_mode != QUALITY_BUDGET || best_child <= worst_child) return flip_budget;
+
+    double quality = (double) (child_fitness - worst_child) / (best_child - worst_child);
+    quality = max(0.0, min(1.0, quality));
+    return max(1, (int) (flip_budget * max(MIN_BUDGET_FRACTION, 2 * quality)));
+}
+
+/**
+ * @brief Offers the population to the elite archive and, every relink_interval
+ * generations, relinks pairs of its members; the best member then takes the
+ * place of the worst individual
+ *
+ * @param relinker The path relinking solver
+ */
+void MemeticAlgorithmSolver::intensify(PathRelinkingSolver &relinker) {
+    for (uint i = 0; i < population_size; i++) archive.add(population[i], fitness[i]);
+    if ((generation + 1) % relink_interval) return;
+
+    relinker.intensify(archive, RELINK_PAIRS);
+    if (relinker.optimal_n_satisfied > optimal_n_satisfied) {
+        optimal_n_satisfied = relinker.optimal_n_satisfied;
+        optimal_assignment = relinker.optimal_assignment;
+    }
+    optimal_found = optimal_n_satisfied >= upper_bound;
+
+    int best = archive.best(), worst = 0;
+    for (uint i = 1; i < population_size; i++)
+        if (fitness[i] < fitness[worst]) worst = i;
+
+    if (archive.fitness[best] > fitness[worst]) {
+        population[worst] = archive.solutions[best];
+        fitness[worst] = archive.fitness[best];
+    }
+}
+
 /**
  * @brief Selects the best solution from the population using tournament
  * selection
@@ -186,55 +361,208 @@ void MemeticAlgorithmSolver::select_elite(
     }
 }
 
+/**
+ * @brief Builds each child taking every variable from a random parent
+ *
+ * @param parents Indices of the parents
+ * @param children [out] The children
+ * @param children_fitness [out] Number of clauses satisfied by each child
+ * @param worker The worker of the pool that runs the task
+ */
 void MemeticAlgorithmSolver::uniform_recombination(
-    vector<vector<bool>> &parents,
-    vector<vector<bool>> &children
+    const vector<int> &parents,
+    vector<vector<bool>> &children,
+    vector<int> &children_fitness,
+    int worker
 ) {
-    // For each variable 
-    for (int i = 0; i < instance.n_vars; i++) {
-        // For each children 
-        for (uint j = 0; j < children.size(); j++) {
-            // Choose a random parent and add its value to the children
-            int parent_index = rand() % parents.size();
-            children[j].push_back(parents[parent_index][i]);
+    vector<bool> values(instance.n_vars);
+    for (uint j = 0; j < children.size(); j++) {
+        // Choose a random parent for each variable
+        for (int i = 0; i < instance.n_vars; i++)
+            values[i] = population[parents[pool.next_random(worker) % parents.size()]][i];
+
+        score_child(parents, values, children[j], children_fitness[j]);
+    }
+}
+
+/**
+ * @brief Builds each child from two random parents, taking a random segment of
+ * variables from the second one and the rest from the first one
+ *
+ * @param parents Indices of the parents
+ * @param children [out] The children
+ * @param children_fitness [out] Number of clauses satisfied by each child
+ * @param worker The worker of the pool that runs the task
+ */
+void MemeticAlgorithmSolver::segment_recombination(
+    const vector<int> &parents,
+    vector<vector<bool>> &children,
+    vector<int> &children_fitness,
+    int worker
+) {
+    vector<bool> values(instance.n_vars);
+    for (uint j = 0; j < children.size(); j++) {
+        int outer = parents[pool.next_random(worker) % parents.size()];
+        int inner = parents[pool.next_random(worker) % parents.size()];
+        int begin = pool.next_random(worker) % instance.n_vars;
+        int end = pool.next_random(worker) % instance.n_vars;
+        if (begin > end) swap(begin, end);
+
+        values = population[outer];
+        for (int i = begin; i < end; i++) values[i] = population[inner][i];
+
+        score_child(parents, values, children[j], children_fitness[j]);
+    }
+}
+
+/**
+ * @brief Builds each child from two random parents with the clause crossover
+ * of the worker, which also repairs it
+ *
+ * @param parents Indices of the parents
+ * @param children [out] The children
+ * @param children_fitness [out] Number of clauses satisfied by each child
+ * @param worker The worker of the pool that runs the task
+ */
+void MemeticAlgorithmSolver::clause_recombination(
+    const vector<int> &parents,
+    vector<vector<bool>> &children,
+    vector<int> &children_fitness,
+    int worker
+) {
+    ClauseCrossover &crossover = clause_crossovers[worker];
+    for (uint j = 0; j < children.size(); j++) {
+        int parent1 = parents[pool.next_random(worker) % parents.size()];
+        int parent2 = parents[pool.next_random(worker) % parents.size()];
+        int start = pool.next_random(worker) % max(1, instance.n_clauses);
+
+        children_fitness[j] = crossover.cross(
+            population[parent1], population[parent2], start, children[j]
+        );
+    }
+}
+
+/**
+ * @brief Sets a child to the given values. Its fitness is computed from the
+ * parent it differs less from, flipping one by one the variables where they
+ * differ
+ *
+ * @param parents Indices of the parents
+ * @param values Values of the child
+ * @param child [out] The child
+ * @param child_fitness [out] Number of clauses satisfied by the child
+ */
+void MemeticAlgorithmSolver::score_child(
+    const vector<int> &parents,
+    const vector<bool> &values,
+    vector<bool> &child,
+    int &child_fitness
+) {
+    int nearest = parents[0], nearest_distance = instance.n_vars + 1;
+    for (int parent : parents) {
+        int distance = 0;
+        for (int i = 0; i < instance.n_vars; i++)
+            distance += values[i] != population[parent][i];
+        if (distance < nearest_distance) {
+            nearest = parent;
+            nearest_distance = distance;
         }
     }
+
+    child = population[nearest];
+    child_fitness = fitness[nearest];
+    for (int i = 0; i < instance.n_vars; i++) {
+        if (child[i] == values[i]) continue;
+        child[i] = values[i];
+        child_fitness = eval_function(child, i, child_fitness);
+    }
 }
 
 /**
- * @brief Mutate a solution
+ * @brief Mutate a solution, updating its fitness after each flip
  *
  * @param solution The solution to mutate
+ * @param n_satisfied Number of clauses satisfied by the solution
+ * @param worker The worker of the pool that runs the task
+ * @return int The number of clauses satisfied by the mutated solution
  */
-int MemeticAlgorithmSolver::mutate(vector<bool> &solution) {
-    if (rand() % 100 < mutation_probability) {
+int MemeticAlgorithmSolver::mutate(vector<bool> &solution, int n_satisfied, int worker) {
+    if ((int) (pool.next_random(worker) % 100) < mutation_probability) {
         for (int i = 0; i < instance.n_vars; i++) {
-            if (rand() % 100 < mutation_percent)
+            if ((int) (pool.next_random(worker) % 100) < mutation_percent * mutation_boost) {
                 solution[i] = !solution[i];
+                n_satisfied = eval_function(solution, i, n_satisfied);
+            }
         }
     }
 
-    return compute_n_satisfied(solution);
+    return n_satisfied;
+}
+
+/**
+ * @brief Evaluates the given assignment
+ * 
+ * @param assignment The assignment to be evaluated
+ * @param flipped_var The variable that was flipped to obtain the assignment
+ * @return int The new number of satisfied clauses of the assignment
+ */
+int MemeticAlgorithmSolver::eval_function(
+    vector<bool> &assignment,
+    int flipped_var,
+    int current_n_satisfied
+) {
+    int new_n_satisfied = current_n_satisfied;
+
+    // Scan the clauses affected by the flipped variable
+    for (auto i : affected_clauses[flipped_var]) {
+
+        bool already_satisfied = false;
+        int flipped_literal = -1;
+
+        for (auto literal : instance.clauses[i]) {
+            if (literal>>1 == flipped_var) {
+                if (flipped_literal == -1) flipped_literal = literal;
+                else if (flipped_literal != literal) {
+                    // Edge case: the clause contains p v -p
+                    already_satisfied = true;
+                    break;
+                }
+                continue;
+            }
+
+            // Check if the clause was already satisfied regardless of the flip
+            already_satisfied = instance.is_literal_true(literal, assignment);
+            if (already_satisfied) break;
+        }
+
+        // If the clause was not already satisfied, check how the flip affects
+        if (!already_satisfied) {
+            if (instance.is_literal_true(flipped_literal, assignment)) 
+                new_n_satisfied++;
+            else
+                new_n_satisfied--;
+        }
+    }
+
+    return new_n_satisfied;
 }
 
 /**
  * @brief Tournament selection
  *
- * @return vector<bool> The selected solution
+ * @param worker The worker of the pool that runs the task
+ * @return int The index of the selected solution
  */
-vector<bool> MemeticAlgorithmSolver::tournament_selection() {
-    vector<bool> best_solution;
-    int best_fitness = -1;
+int MemeticAlgorithmSolver::tournament_selection(int worker) {
+    int best_index = -1;
 
     // Choose tournament_size random solutions and select the best one
     for (int i = 0; i < tournament_size; i++) {
-        int index = rand() % population_size;
-        if (fitness[index] > best_fitness) {
-            best_fitness = fitness[index];
-            best_solution = population[index];
-        }
+        int index = pool.next_random(worker) % population_size;
+        if (best_index == -1 || fitness[index] > fitness[best_index])
+            best_index = index;
     }
-    return best_solution;
+    return best_index;
 }
 
 void MemeticAlgorithmSolver::print_solution() {
@@ -245,6 +573,37 @@ void MemeticAlgorithmSolver::print_solution() {
     cout << "c mutation_probability = " << mutation_probability << endl;
     cout << "c mutation_percent = " << mutation_percent << endl;
     cout << "c elite_percent = " << elite_percent << endl;
+    cout << "c relink_interval = " << relink_interval << endl;
+    cout << "c recombination = " << recombination << endl;
+    cout << "c operator_policy = " << operator_policy << endl;
+    if (operator_policy != FIXED_OPERATORS) {
+        cout << "c recombination operator uses =";
+        for (long long n : recombination_operators.n_uses) cout << " " << n;
+        cout << endl;
+    }
+    long long n_calls = 0, n_steps = 0;
+    for (auto &local : improvers) {
+        n_calls += local.n_calls;
+        n_steps += local.n_steps;
+    }
+    cout << "c n_threads = " << n_threads << endl;
+    cout << "c tasks run = " << pool.n_tasks_run << ", stolen = " << pool.n_steals << endl;
+    cout << "c improver = " << improver << endl;
+    cout << "c flip_budget = " << flip_budget << endl;
+    cout << "c budget_mode = " << budget_mode << endl;
+    cout << "c improvement steps per individual = ";
+    cout << (n_calls ? (double) n_steps / n_calls : 0) << endl;
+    if (!clause_crossovers.empty()) {
+        long long n_children = 0, n_repairs = 0;
+        for (auto &crossover : clause_crossovers) {
+            n_children += crossover.n_children;
+            n_repairs += crossover.n_repairs;
+        }
+        cout << "c clause crossovers = " << n_children;
+        cout << ", repair flips = " << n_repairs << endl;
+    }
+    cout << "c diversity_response = " << diversity_response << endl;
+    diversity.print_trace();
     cout << "c seed = " << seed << endl;
     MaxSATSolver::print_solution();
 }
@@ -0,0 +1,222 @@
+/**
+ * Implementation of a multilevel Max-SAT solver
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/MultilevelSolver.hpp"
+#include "../include/ClauseWeightingSolver.hpp"
+
+using namespace std;
+
+/**
+ * @brief Prepares the multilevel search over the instance to be solved
+ *
+ * @param instance The SAT instance
+ * @param coarsest_vars Coarsening stops once a level has at most this number
+ * of variables
+ * @param flips_per_var Flips of the local search on each level, per variable
+ * of the level
+ * @param seed The seed for the random number generator
+ */
+MultilevelSolver::MultilevelSolver(
+    const SATInstance &instance,
+    int coarsest_vars,
+    int flips_per_var,
+    uint seed
+) : MaxSATSolver(instance),
+    seed(seed),
+    coarsest_vars(coarsest_vars),
+    flips_per_var(flips_per_var)
+{
+    optimal_assignment = vector<bool>(instance.n_vars, false);
+}
+
+/**
+ * @brief Solves the instance: the coarsest level starts from a random
+ * assignment, and the assignment refined on each level is the starting point
+ * of the next finer one
+ */
+void MultilevelSolver::solve() {
+    compute_upper_bound();
+
+    srand(seed);
+    coarsen();
+
+    vector<bool> assignment(levels.back().n_vars);
+    for (uint i = 0; i < assignment.size(); i++) assignment[i] = rand() & 1;
+
+    for (int level = levels.size() - 1; level >= 0; level--) {
+        if (!optimal_found) refine(level, assignment);
+        if (level > 0) assignment = project(assignment, projections[level - 1]);
+    }
+
+    optimal_assignment = assignment;
+    optimal_n_satisfied = compute_n_satisfied(optimal_assignment);
+    optimal_found = optimal_n_satisfied >= upper_bound;
+}
+
+/**
+ * @brief Builds the levels, merging variables until the formula is small
+ * enough or merging no longer shrinks it
+ */
+void MultilevelSolver::coarsen() {
+    levels = {instance};
+    projections.clear();
+    n_dropped = {0};
+
+    while (levels.size() < MAX_LEVELS && levels.back().n_vars > coarsest_vars) {
+        vector<int> projection;
+        int n_tautologies;
+        SATInstance coarse = merge_vars(levels.back(), projection, n_tautologies);
+        if (coarse.n_vars > 0.9 * levels.back().n_vars) break;
+
+        levels.push_back(move(coarse));
+        projections.push_back(move(projection));
+        n_dropped.push_back(n_dropped.back() + n_tautologies);
+    }
+}
+
+/**
+ * @brief Matches each variable with the unmatched variable it shares the most
+ * clauses with (at least MIN_SHARED_CLAUSES, so that only strongly related
+ * variables are merged), and merges both into a single variable of the coarse
+ * formula.
+ * If they appear more often with the same sign, the second one takes the
+ * negated value, so those clauses are always satisfied; otherwise it takes
+ * the same value. Clauses that become tautologies are dropped
+ *
+ * @param fine The formula to be coarsened
+ * @param projection [out] Literal of the coarse formula that gives the value
+ * of each variable of the fine one
+ * @param n_tautologies [out] Number of clauses dropped
+ * @return SATInstance The coarse formula
+ */
+SATInstance MultilevelSolver::merge_vars(
+    const SATInstance &fine,
+    vector<int> &projection,
+    int &n_tautologies
+) {
+    vector<vector<pair<int, int>>> occurrences(fine.n_vars);
+    for (int i = 0; i < fine.n_clauses; i++)
+        for (int literal : fine.clauses[i])
+            occurrences[literal>>1].push_back(make_pair(i, literal));
+
+    // Visit the variables in random order
+    vector<int> order(fine.n_vars);
+    for (int i = 0; i < fine.n_vars; i++) order[i] = i;
+    for (int i = fine.n_vars - 1; i > 0; i--) swap(order[i], order[rand() % (i + 1)]);
+
+    projection = vector<int>(fine.n_vars, -1);
+    vector<int> n_same(fine.n_vars, 0);
+    vector<int> n_opposite(fine.n_vars, 0);
+    vector<int> neighbors;
+    int n_coarse = 0;
+
+    for (int var : order) {
+        if (projection[var] != -1) continue;
+
+        // Count the clauses shared with each unmatched neighbor
+        neighbors.clear();
+        for (auto &occurrence : occurrences[var]) {
+            for (int literal : fine.clauses[occurrence.first]) {
+                int other = literal>>1;
+                if (other == var || projection[other] != -1) continue;
+
+                if (!n_same[other] && !n_opposite[other]) neighbors.push_back(other);
+                if ((literal & 1) == (occurrence.second & 1)) n_same[other]++;
+                else n_opposite[other]++;
+            }
+        }
+
+        int best = -1;
+        int best_weight = MIN_SHARED_CLAUSES - 1;
+        for (int other : neighbors) {
+            int weight = max(n_same[other], n_opposite[other]);
+            if (weight > best_weight) {
+                best_weight = weight;
+                best = other;
+            }
+        }
+
+        projection[var] = 2 * n_coarse;
+        if (best != -1)
+            projection[best] = 2 * n_coarse + (n_same[best] > n_opposite[best]);
+        n_coarse++;
+
+        for (int other : neighbors) n_same[other] = n_opposite[other] = 0;
+    }
+
+    // Rewrite the clauses over the coarse variables
+    vector<vector<int>> clauses;
+    vector<int> seen(2 * n_coarse, -1);
+    n_tautologies = 0;
+
+    for (int i = 0; i < fine.n_clauses; i++) {
+        vector<int> clause;
+        bool tautology = false;
+        for (int literal : fine.clauses[i]) {
+            int coarse_literal = projection[literal>>1] ^ (literal & 1);
+            if (seen[coarse_literal ^ 1] == i) tautology = true;
+            if (seen[coarse_literal] == i) continue;
+            seen[coarse_literal] = i;
+            clause.push_back(coarse_literal);
+        }
+
+        if (tautology) n_tautologies++;
+        else clauses.push_back(move(clause));
+    }
+
+    return SATInstance(n_coarse, clauses);
+}
+
+/**
+ * @brief Gives each variable of the finer level the value of its literal in
+ * the coarser one
+ *
+ * @param coarse Assignment of the coarser level
+ * @param projection Literal of the coarser level of each variable
+ * @return vector<bool> Assignment of the finer level
+ */
+vector<bool> MultilevelSolver::project(
+    const vector<bool> &coarse,
+    const vector<int> &projection
+) {
+    vector<bool> fine(projection.size());
+    for (uint i = 0; i < projection.size(); i++)
+        fine[i] = coarse[projection[i]>>1] != (projection[i] & 1);
+    return fine;
+}
+
+/**
+ * @brief Improves the assignment of a level with a clause weighting local
+ * search of flips_per_var flips per variable
+ *
+ * @param level The level to be refined
+ * @param assignment [in/out] Assignment of the level
+ */
+void MultilevelSolver::refine(int level, vector<bool> &assignment) {
+    ClauseWeightingSolver solver(levels[level], 15, 0.01, 300, seed + level);
+
+    // Dropped tautologies are satisfied on every finer level
+    solver.set_upper_bound(upper_bound - n_dropped[level]);
+    solver.max_flips = flips_per_var * levels[level].n_vars;
+    solver.optimal_assignment = assignment;
+    solver.solve();
+
+    assignment = solver.optimal_assignment;
+    optimal_found = solver.optimal_found;
+}
+
+void MultilevelSolver::print_solution() {
+    cout << "c Multilevel Solver" << endl;
+    cout << "c coarsest_vars = " << coarsest_vars << endl;
+    cout << "c flips_per_var = " << flips_per_var << endl;
+    cout << "c levels = " << levels.size() << endl;
+    cout << "c seed = " << seed << endl;
+    MaxSATSolver::print_solution();
+}
@@ -0,0 +1,120 @@
+/**
+ * Adaptive selection of the operators of an evolutionary algorithm
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../include/OperatorSelector.hpp"
+
+using namespace std;
+
+/**
+ * @brief Starts with the same quality and probability for every operator
+ *
+ * @param n_operators Number of operators
+ * @param policy FIXED_OPERATORS, ADAPTIVE_PURSUIT or UCB_SELECTION
+ */
+OperatorSelector::OperatorSelector(int n_operators, int policy)
+    : n_operators(n_operators),
+      policy(policy),
+      quality(n_operators, 0),
+      probability(n_operators, 1.0 / n_operators),
+      n_uses(n_operators, 0),
+      improvement(n_operators, 0),
+      seconds(n_operators, 0),
+      n_calls(n_operators, 0),
+      n_rewards(n_operators, 0)
+{
+}
+
+/**
+ * @brief Chooses an operator. Only reads the state changed by update(), so it
+ * can be called from several threads during a generation
+ *
+ * @param random A uniform random number in [0, 1)
+ * @return int The operator
+ */
+int OperatorSelector::select(double random) {
+    if (policy == FIXED_OPERATORS || n_operators == 1) return 0;
+
+    if (policy == ADAPTIVE_PURSUIT) {
+        for (int i = 0; i < n_operators - 1; i++) {
+            random -= probability[i];
+            if (random < 0) return i;
+        }
+        return n_operators - 1;
+    }
+
+    // UCB: every operator is tried once, then the rewards are normalized by
+    // the best quality so that the exploration term has the same scale
+    double max_quality = 0;
+    for (int i = 0; i < n_operators; i++) {
+        if (!n_rewards[i]) return i;
+        max_quality = max(max_quality, quality[i]);
+    }
+
+    int best = 0;
+    double best_score = -1;
+    for (int i = 0; i < n_operators; i++) {
+        double score = max_quality > 0 ? quality[i] / max_quality : 0;
+        score += UCB_EXPLORATION * sqrt(log(n_updates) / n_rewards[i]);
+        if (score > best_score) {
+            best = i;
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Records a use of an operator, safe to call from several threads
+ *
+ * @param op The operator
+ * @param gain Improvement produced, 0 if it did not improve
+ * @param elapsed Seconds spent in the operator
+ */
+void OperatorSelector::record(int op, double gain, double elapsed) {
+    #pragma omp atomic
+    improvement[op] += gain;
+    #pragma omp atomic
+    seconds[op] += elapsed;
+    #pragma omp atomic
+    n_calls[op]++;
+}
+
+/**
+ * @brief Turns the records of the used operators into rewards, the
+ * improvement per second, and updates the qualities and the probabilities
+ */
+void OperatorSelector::update() {
+    n_updates++;
+
+    for (int i = 0; i < n_operators; i++) {
+        if (!n_calls[i]) continue;
+
+        double reward = improvement[i] / max(seconds[i], 1e-9);
+        n_uses[i] += n_calls[i];
+        n_rewards[i]++;
+
+        if (policy == UCB_SELECTION) quality[i] += (reward - quality[i]) / n_rewards[i];
+        else quality[i] += PURSUIT_ADAPTATION * (reward - quality[i]);
+
+        improvement[i] = seconds[i] = n_calls[i] = 0;
+    }
+
+    if (policy != ADAPTIVE_PURSUIT) return;
+
+    // Move the probability of the best operator towards the maximum and the
+    // others towards the minimum
+    double min_probability = PURSUIT_MIN_FRACTION / n_operators;
+    double max_probability = 1 - (n_operators - 1) * min_probability;
+    int best = max_element(quality.begin(), quality.end()) - quality.begin();
+    for (int i = 0; i < n_operators; i++) {
+        double target = i == best ? max_probability : min_probability;
+        probability[i] += PURSUIT_LEARNING_RATE * (target - probability[i]);
+    }
+}
@@ -0,0 +1,122 @@
+/**
+ * Implementation of a Max-SAT solver based on parallel tempering (replica
+ * exchange simulated annealing)
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <cmath>
+#include <iostream>
+#include <omp.h>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/ParallelTemperingSolver.hpp"
+
+using namespace std;
+
+/**
+ * @brief Creates the replicas, each one from its own constructed assignment,
+ * and the temperature ladder
+ *
+ * @param instance The SAT instance
+ * @param n_replicas Number of replicas, each one run by a thread
+ * @param min_temperature Temperature of the coldest replica
+ * @param max_temperature Temperature of the hottest replica
+ * @param seed The seed for the random number generator
+ * @param construction The method that builds the initial assignments, see
+ * GreedyConstruction
+ */
+ParallelTemperingSolver::ParallelTemperingSolver(
+    const SATInstance &instance,
+    int n_replicas,
+    double min_temperature,
+    double max_temperature,
+    uint seed,
+    int construction
+) : MaxSATSolver(instance),
+    seed(seed),
+    construction(construction),
+    n_replicas(n_replicas),
+    temperatures(n_replicas),
+    rung_replica(n_replicas)
+{
+    replicas.reserve(n_replicas);
+    for (int i = 0; i < n_replicas; i++) {
+        replicas.emplace_back(instance, 0, seed + i, construction);
+
+        double t = n_replicas > 1 ? i / (double) (n_replicas - 1) : 0;
+        temperatures[i] = min_temperature * pow(max_temperature / min_temperature, t);
+        rung_replica[i] = i;
+    }
+
+    srand(seed);
+}
+
+/**
+ * @brief Runs a temperature step of every replica in parallel, exchanges
+ * temperatures and updates the incumbent, until the replicas have made
+ * MAX_PROPOSALS proposals each or the upper bound is reached
+ */
+void ParallelTemperingSolver::solve() {
+    compute_upper_bound();
+
+    for (int i = 0; i < n_replicas; i++) {
+        replicas[rung_replica[i]].temperature = temperatures[i];
+        replicas[i].set_upper_bound(upper_bound);
+        replicas[i].start();
+    }
+
+    while (instance.n_vars && replicas[0].n_proposals < MAX_PROPOSALS) {
+        #pragma omp parallel for num_threads(n_replicas)
+        for (int i = 0; i < n_replicas; i++) replicas[i].step();
+        rounds++;
+
+        for (auto &replica : replicas) {
+            if (replica.optimal_n_satisfied <= optimal_n_satisfied) continue;
+            replica.save_best();
+            optimal_n_satisfied = replica.optimal_n_satisfied;
+            optimal_assignment = replica.optimal_assignment;
+        }
+
+        optimal_found = optimal_n_satisfied >= upper_bound;
+        if (optimal_found) break;
+
+        exchange();
+    }
+}
+
+/**
+ * @brief Swaps the temperatures of adjacent replicas, alternating between the
+ * even and the odd pairs of rungs. Rungs k and k + 1 swap with probability
+ * min(1, exp((1/T_k - 1/T_k+1) (E_k - E_k+1))), E being the number of
+ * unsatisfied clauses
+ */
+void ParallelTemperingSolver::exchange() {
+    for (int k = rounds % 2; k + 1 < n_replicas; k += 2) {
+        SimulatedAnnealingSolver &cold = replicas[rung_replica[k]];
+        SimulatedAnnealingSolver &hot = replicas[rung_replica[k+1]];
+
+        // E_k - E_k+1 is the number of satisfied clauses of k+1 minus k
+        double energy_difference = hot.evaluator.n_satisfied - cold.evaluator.n_satisfied;
+        double exponent = (1 / temperatures[k] - 1 / temperatures[k+1]) * energy_difference;
+        if (exponent < 0 && (double) rand() / RAND_MAX >= exp(exponent)) continue;
+
+        swap(rung_replica[k], rung_replica[k+1]);
+        replicas[rung_replica[k]].temperature = temperatures[k];
+        replicas[rung_replica[k+1]].temperature = temperatures[k+1];
+        n_swaps++;
+    }
+}
+
+void ParallelTemperingSolver::print_solution() {
+    cout << "c Parallel Tempering Solver" << endl;
+    cout << "c MAX_PROPOSALS = " << MAX_PROPOSALS << endl;
+    cout << "c n_replicas = " << n_replicas << endl;
+    cout << "c min_temperature = " << temperatures[0] << endl;
+    cout << "c max_temperature = " << temperatures[n_replicas-1] << endl;
+    cout << "c rounds = " << rounds << endl;
+    cout << "c n_swaps = " << n_swaps << endl;
+    cout << "c seed = " << seed << endl;
+    MaxSATSolver::print_solution();
+}
@@ -0,0 +1,182 @@
+/**
+ * Implementation of a Max-SAT solver based on path relinking between the
+ * members of an elite archive
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/PathRelinkingSolver.hpp"
+
+using namespace std;
+
+/**
+ * @brief Creates the solver with an empty archive
+ *
+ * @param instance The SAT instance
+ * @param archive_size Maximum number of assignments in the archive
+ * @param min_distance Minimum Hamming distance between two archive members
+ * @param seed The seed for the random number generator
+ * @param construction The method that builds the assignments of the archive,
+ * see GreedyConstruction
+ */
+PathRelinkingSolver::PathRelinkingSolver(
+    const SATInstance &instance,
+    int archive_size,
+    int min_distance,
+    uint seed,
+    int construction
+) : MaxSATSolver(instance),
+    seed(seed),
+    construction(construction),
+    archive(instance.n_vars, archive_size, min_distance),
+    evaluator(instance),
+    random_state(seed * 2654435761ULL + 1)
+{
+}
+
+/**
+ * @brief Fills the archive with local optima of constructed assignments and
+ * relinks random pairs of members until MAX_RELINKS
+ */
+void PathRelinkingSolver::solve() {
+    compute_upper_bound();
+
+    // Only the constructed assignments draw from the global generator
+    srand(seed);
+
+    GreedyConstruction greedy(instance);
+    for (int i = 0; i < 2 * archive.capacity; i++) {
+        evaluator.reset(greedy.construct(construction));
+        descend();
+        archive.add(evaluator.assignment, evaluator.n_satisfied);
+
+        if (evaluator.n_satisfied > optimal_n_satisfied) {
+            optimal_n_satisfied = evaluator.n_satisfied;
+            optimal_assignment = evaluator.assignment;
+        }
+    }
+
+    optimal_found = optimal_n_satisfied >= upper_bound;
+    while (!optimal_found && relinks < MAX_RELINKS && archive.size() > 1)
+        intensify(archive, archive.capacity);
+}
+
+/**
+ * @brief Relinks random pairs of archive members, in both directions, and
+ * offers the results to the archive
+ *
+ * @param archive The elite archive
+ * @param n_pairs Number of pairs to relink
+ */
+void PathRelinkingSolver::intensify(EliteArchive &archive, int n_pairs) {
+    for (int k = 0; k < n_pairs && archive.size() > 1; k++) {
+        int i = next_random() % archive.size();
+        int j = next_random() % (archive.size() - 1);
+        if (j >= i) j++;
+
+        for (int direction = 0; direction < 2; direction++) {
+            relink(archive.solutions[i], archive.solutions[j]);
+            relinks++;
+            swap(i, j);
+
+            if (evaluator.n_satisfied > optimal_n_satisfied) {
+                optimal_n_satisfied = evaluator.n_satisfied;
+                optimal_assignment = evaluator.assignment;
+            }
+
+            // The members may move once the result is admitted
+            archive.add(evaluator.assignment, evaluator.n_satisfied);
+
+            optimal_found = optimal_n_satisfied >= upper_bound;
+            if (optimal_found) return;
+        }
+    }
+}
+
+/**
+ * @brief Walks from the initiating assignment towards the guiding one,
+ * flipping at each step the differing variable with the best score (among
+ * RELINK_SAMPLES random ones when there are more). The walk stops one flip
+ * before the guiding assignment, goes back to the best assignment of the path
+ * and descends from it
+ *
+ * @param initial The initiating assignment
+ * @param guiding The guiding assignment
+ * @return int The number of satisfied clauses of the result, which is left in
+ * the evaluator
+ */
+int PathRelinkingSolver::relink(
+    const vector<bool> &initial,
+    const vector<bool> &guiding
+) {
+    evaluator.reset(initial);
+
+    diff.clear();
+    for (int i = 0; i < instance.n_vars; i++)
+        if (initial[i] != guiding[i]) diff.push_back(i);
+
+    path.clear();
+    int best_step = 0, best_n_satisfied = -1;
+    while (diff.size() > 1) {
+        int n_diff = diff.size();
+        int n_samples = n_diff <= RELINK_SAMPLES ? n_diff : RELINK_SAMPLES;
+
+        int best_index = -1;
+        for (int s = 0; s < n_samples; s++) {
+            int index = n_diff <= RELINK_SAMPLES ? s : next_random() % n_diff;
+            if (best_index == -1 || evaluator.score[diff[index]] > evaluator.score[diff[best_index]])
+                best_index = index;
+        }
+
+        int var = diff[best_index];
+        diff[best_index] = diff.back();
+        diff.pop_back();
+
+        evaluator.flip(var);
+        path.push_back(var);
+
+        if (evaluator.n_satisfied > best_n_satisfied) {
+            best_n_satisfied = evaluator.n_satisfied;
+            best_step = path.size();
+        }
+    }
+
+    // Go back to the best assignment of the path
+    for (int i = path.size() - 1; i >= best_step; i--) evaluator.flip(path[i]);
+
+    descend();
+    return evaluator.n_satisfied;
+}
+
+/**
+ * @brief Flips variables with positive score until there is none left
+ */
+void PathRelinkingSolver::descend() {
+    evaluator.update_good_vars();
+    while (evaluator.good_vars.size()) {
+        evaluator.flip(evaluator.good_vars[next_random() % evaluator.good_vars.size()]);
+        evaluator.update_good_vars();
+    }
+}
+
+uint32_t PathRelinkingSolver::next_random() {
+    random_state ^= random_state >> 12;
+    random_state ^= random_state << 25;
+    random_state ^= random_state >> 27;
+    return (random_state * 2685821657736338717ULL) >> 32;
+}
+
+void PathRelinkingSolver::print_solution() {
+    cout << "c Path Relinking Solver" << endl;
+    cout << "c MAX_RELINKS = " << MAX_RELINKS << endl;
+    cout << "c RELINK_SAMPLES = " << RELINK_SAMPLES << endl;
+    cout << "c archive_size = " << archive.capacity << endl;
+    cout << "c min_distance = " << archive.min_distance << endl;
+    cout << "c relinks = " << relinks << endl;
+    cout << "c seed = " << seed << endl;
+    MaxSATSolver::print_solution();
+}
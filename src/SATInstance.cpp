@@ -62,6 +62,15 @@ SATInstance::SATInstance(string filename) {
     file.close();
 }
 
+/**
+ * @brief Build a SAT instance from clauses already mapped to literals
+ * 
+ * @param n_vars number of variables
+ * @param clauses clauses of the instance
+ */
+SATInstance::SATInstance(int n_vars, const vector<vector<int>> &clauses)
+    : n_vars(n_vars), n_clauses(clauses.size()), clauses(clauses) {}
+
 /**
  * @brief Check if a given literal is satisfied by an assignment
  * 
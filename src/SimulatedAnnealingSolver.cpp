@@ -5,6 +5,7 @@
  */
 #include <iostream>
 #include <cmath>
+#include <cstdint>
 
 #include "../include/SATInstance.hpp"
 #include "../include/SimulatedAnnealingSolver.hpp"
@@ -14,148 +15,204 @@
  * the given seed
  * 
  * @param instance The SAT instance
+ * @param cooling_factor Speed of the cooling schedule
  * @param seed The seed for the random number generator
+ * @param construction The method that builds the initial assignment, see
+ * GreedyConstruction
  */
 SimulatedAnnealingSolver::SimulatedAnnealingSolver(
     const SATInstance &instance,
     double cooling_factor,
-    uint seed
+    uint seed,
+    int construction
 ) : MaxSATSolver(instance),
     seed(seed),
-    cooling_factor(cooling_factor)
+    construction(construction),
+    cooling_factor(cooling_factor),
+    evaluator(instance),
+    random_state(seed * 2654435761ULL + 1)
 {
-    // Initialize the optimal assignment with random values
+    // Initialize the optimal assignment
     srand(seed);
-    for (int i = 0; i < instance.n_vars; i++)
-        optimal_assignment.push_back(rand() & 1);
+    optimal_assignment = GreedyConstruction(instance).construct(construction);
 
     optimal_n_satisfied = compute_n_satisfied(optimal_assignment);
 
-    // Calculate initial temperature
-    double n_flips = instance.n_vars / 2;
+    // The initial temperature is 50 times the average |delta n_satisfied| of
+    // a random flip
+    evaluator.reset(optimal_assignment);
+    int n_flips = instance.n_vars / 2;
     initial_temperature = 0;
+    for (int i = 0; i < n_flips; i++)
+        initial_temperature += abs(evaluator.score[rand() % instance.n_vars]) / (double) n_flips;
 
-    int aux_n_satisfied = optimal_n_satisfied;
-    vector<bool> aux_assignment = optimal_assignment;
+    initial_temperature *= 50;
+    temperature = initial_temperature;
 
-    // Take a random variable and flip it, calculate the average
-    // |delta n_satisfied| for each flip
-    for (int i = 0; i < n_flips; i++) {
-        int j = rand() % instance.n_vars;
-        aux_assignment[j] = !aux_assignment[j];
+    // No flip changes more clauses than the variable appears in
+    uint max_occurrences = 0;
+    for (auto &occurrences : evaluator.occurrences)
+        max_occurrences = max(max_occurrences, (uint) occurrences.size());
+    acceptance = vector<uint32_t>(max_occurrences + 1);
+}
 
-        int new_n_satisfied = eval_function(aux_assignment, j, aux_n_satisfied);
-        initial_temperature += (
-            abs(new_n_satisfied - aux_n_satisfied) / (double) n_flips
-        );
-        aux_n_satisfied = new_n_satisfied;
+/**
+ * @brief Solves the instance with simulated annealing, cooling after every
+ * temperature step. The best assignment is only copied when the flip log
+ * fills up and at the end
+ */
+void SimulatedAnnealingSolver::solve() {
+    compute_upper_bound();
 
-        if (aux_n_satisfied > optimal_n_satisfied) {
-            optimal_n_satisfied = aux_n_satisfied;
-            optimal_assignment = aux_assignment;
-        }
-    }
+    start();
+    while (!optimal_found && instance.n_vars && n_proposals < MAX_PROPOSALS)
+        cool(step());
 
-    initial_temperature *= 50;
-    temperature = initial_temperature;
+    save_best();
 }
 
-void SimulatedAnnealingSolver::solve() {
-    vector<bool> assignment = optimal_assignment;
-
-    int internal_n_satisfied = optimal_n_satisfied;
-    while (iterations < MAX_CYCLES && temperature > 0) {
-        
-        // While true, try to find a neighbor that improves the solution
-        while (true) {
-            // Take a random neighbor (flip a random variable)
-            int i = rand() % instance.n_vars;
-            assignment[i] = !assignment[i];
-
-            int new_n_satisfied = eval_function(assignment, i, internal_n_satisfied);
-            bool improved = new_n_satisfied > optimal_n_satisfied;
-
-            // Calculate the probability of accepting the neighbor
-            double probability = improved ? 1 : 
-                exp((new_n_satisfied - optimal_n_satisfied) / temperature);
-
-            // With probability p keeps the current solution
-            if (improved || (double) rand() / RAND_MAX < probability) {
-                if (improved) {
-                    optimal_assignment = assignment;
-                    optimal_n_satisfied = new_n_satisfied;
-                }
-
-                internal_n_satisfied = new_n_satisfied;
-                break;
-            }
+/**
+ * @brief Starts the search from optimal_assignment
+ */
+void SimulatedAnnealingSolver::start() {
+    evaluator.reset(optimal_assignment);
+    optimal_n_satisfied = evaluator.n_satisfied;
+    log_start = evaluator.assignment;
+    flip_log.clear();
+    best_step = -1;
+
+    optimal_found = optimal_n_satisfied >= upper_bound;
+}
 
-            assignment[i] = !assignment[i];
+/**
+ * @brief Runs a temperature step: n_vars flips of random variables are
+ * proposed; a flip that does not break more clauses than it makes is
+ * accepted, otherwise it is accepted with probability exp(delta / temperature),
+ * read from the acceptance table
+ *
+ * @return double The fraction of the worsening flips that were accepted
+ */
+double SimulatedAnnealingSolver::step() {
+    compute_acceptance();
+
+    int n_vars = instance.n_vars;
+    int n_worse = 0, n_accepted_worse = 0;
+    bool improved = false;
+    for (int k = 0; k < n_vars; k++) {
+        int var = ((uint64_t) next_random() * n_vars) >> 32;
+        int delta = evaluator.score[var];
+
+        if (delta < 0) {
+            n_worse++;
+            if (next_random() >= acceptance[-delta]) continue;
+            n_accepted_worse++;
         }
 
-        if (optimal_n_satisfied == instance.n_clauses) {
-            optimal_found = true;
-            break;
+        evaluator.flip(var);
+        flip_log.push_back(var);
+
+        if (evaluator.n_satisfied > optimal_n_satisfied) {
+            optimal_n_satisfied = evaluator.n_satisfied;
+            best_step = flip_log.size();
+            improved = true;
+            if (optimal_n_satisfied >= upper_bound) break;
         }
 
-        // Executes logarithmic cooling
-        temperature /= 1 + cooling_factor * log(iterations + 1);
-        iterations++;
+        // Keep the log shorter than an assignment
+        if ((int) flip_log.size() >= n_vars) save_best();
     }
+
+    // Scores are read directly, so the list of good variables is unused
+    evaluator.clear_touched();
+
+    n_proposals += n_vars;
+    iterations++;
+    steps_without_improvement = improved ? 0 : steps_without_improvement + 1;
+    optimal_found = optimal_n_satisfied >= upper_bound;
+
+    return n_worse ? n_accepted_worse / (double) n_worse : 0;
 }
 
 /**
- * @brief Evaluates the given assignment
- * 
- * @param assignment The assignment to be evaluated
- * @param flipped_var The variable that was flipped to obtain the assignment
- * @return int The new number of satisfied clauses of the assignment
+ * @brief Computes the probability of accepting each possible change for the
+ * current temperature
  */
-int SimulatedAnnealingSolver::eval_function(
-    vector<bool> &assignment,
-    int flipped_var,
-    int current_n_satisfied
-) {
-    int new_n_satisfied = current_n_satisfied;
-
-    // Scan the clauses affected by the flipped variable
-    for (auto i : affected_clauses[flipped_var]) {
-
-        bool already_satisfied = false;
-        int flipped_literal = -1;
-
-        for (auto literal : instance.clauses[i]) {
-            if (literal>>1 == flipped_var) {
-                if (flipped_literal == -1) flipped_literal = literal;
-                else if (flipped_literal != literal) {
-                    // Edge case: the clause contains p v -p
-                    already_satisfied = true;
-                    break;
-                }
-                continue;
-            }
+void SimulatedAnnealingSolver::compute_acceptance() {
+    acceptance[0] = UINT32_MAX;
+    for (uint k = 1; k < acceptance.size(); k++) {
+        double probability = temperature > 0 ? exp(-(double) k / temperature) : 0;
+        acceptance[k] = probability * UINT32_MAX;
+    }
+}
 
-            // Check if the clause was already satisfied regardless of the flip
-            already_satisfied = instance.is_literal_true(literal, assignment);
-            if (already_satisfied) break;
-        }
+/**
+ * @brief Lowers the temperature following the schedule
+ *
+ * @param acceptance_ratio Fraction of the worsening flips accepted in the last
+ * step
+ */
+void SimulatedAnnealingSolver::cool(double acceptance_ratio) {
+    switch (schedule) {
+        case LOGARITHMIC_SCHEDULE:
+            temperature /= 1 + cooling_factor * log(iterations + 1);
+            break;
+
+        case GEOMETRIC_SCHEDULE:
+            temperature *= 1 - cooling_factor;
+            break;
 
-        // If the clause was not already satisfied, check how the flip affects
-        if (!already_satisfied) {
-            if (instance.is_literal_true(flipped_literal, assignment)) 
-                new_n_satisfied++;
-            else
-                new_n_satisfied--;
+        case ADAPTIVE_SCHEDULE: {
+            // Follows a target acceptance ratio that decreases to 0
+            double progress = n_proposals / (double) MAX_PROPOSALS;
+            double target = TARGET_ACCEPTANCE * (1 - progress);
+            if (acceptance_ratio > target) temperature *= 1 - cooling_factor;
+            else temperature *= 1 + cooling_factor;
+            break;
         }
+
+        case REHEATING_SCHEDULE:
+            temperature *= 1 - cooling_factor;
+            if (steps_without_improvement >= REHEAT_STEPS) {
+                temperature = max(temperature, initial_temperature * REHEAT_FRACTION);
+                steps_without_improvement = 0;
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Builds the best assignment from the start of the flip log, if it is
+ * in the log, and starts a new log at the current assignment
+ */
+void SimulatedAnnealingSolver::save_best() {
+    if (best_step >= 0) {
+        optimal_assignment = log_start;
+        for (int i = 0; i < best_step; i++)
+            optimal_assignment[flip_log[i]] = !optimal_assignment[flip_log[i]];
     }
 
-    return new_n_satisfied;
+    log_start = evaluator.assignment;
+    flip_log.clear();
+    best_step = -1;
+}
+
+/**
+ * @brief xorshift64* generator, cheaper than rand() on every proposal
+ */
+uint32_t SimulatedAnnealingSolver::next_random() {
+    random_state ^= random_state >> 12;
+    random_state ^= random_state << 25;
+    random_state ^= random_state >> 27;
+    return (random_state * 2685821657736338717ULL) >> 32;
 }
 
 void SimulatedAnnealingSolver::print_solution() {
     cout << "c Simulated Annealing Solver" << endl;
-    cout << "c MAX_CYCLES = " << MAX_CYCLES << endl;
+    cout << "c MAX_PROPOSALS = " << MAX_PROPOSALS << endl;
+    cout << "c schedule = " << schedule << endl;
     cout << "c cooling_factor = " << cooling_factor << endl;
+    cout << "c initial_temperature = " << initial_temperature << endl;
+    cout << "c iterations = " << iterations << endl;
     cout << "c seed = " << seed << endl;
     MaxSATSolver::print_solution();
-}
\ No newline at end of file
+}
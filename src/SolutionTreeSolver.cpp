@@ -20,23 +20,26 @@ using namespace std;
  * 
  * @param instance The SAT instance
  * @param seed The seed for the random number generator
+ * @param construction The method that builds the initial assignment, see
+ * GreedyConstruction
  */
 SolutionTreeSolver::SolutionTreeSolver(
     const SATInstance &instance,
     int branching_factor,
     int max_depth,
     double alpha,
-    uint seed
+    uint seed,
+    int construction
 ) : MaxSATSolver(instance),
     branching_factor(branching_factor),
     max_depth(max_depth),
     alpha(alpha),
-    seed(seed)
+    seed(seed),
+    construction(construction)
 {
-    // Initialize the optimal assignment with random values
+    // Initialize the optimal assignment
     srand(seed);
-    for (int i = 0; i < instance.n_vars; i++)
-        optimal_assignment.push_back(rand() & 1);
+    optimal_assignment = GreedyConstruction(instance).construct(construction);
 }
 
 /**
@@ -45,6 +48,7 @@ SolutionTreeSolver::SolutionTreeSolver(
  * variable
  */
 void SolutionTreeSolver::solve() {
+    compute_upper_bound();
     optimal_n_satisfied = compute_n_satisfied(optimal_assignment);
 
     while (iteration < MAX_GROWS) {
@@ -85,6 +89,9 @@ void SolutionTreeSolver::solve() {
             q = move(q_aux);
         }
 
+        optimal_found = optimal_n_satisfied >= upper_bound;
+        if (optimal_found) break;
+
         iteration++;
     }
 }
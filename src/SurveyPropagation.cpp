@@ -0,0 +1,271 @@
+/**
+ * Survey propagation with decimation, used to build biased initial
+ * assignments for random k-SAT instances
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <omp.h>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/SurveyPropagation.hpp"
+
+using namespace std;
+
+/**
+ * @brief Builds the clause-variable graph of the instance
+ *
+ * @param instance The SAT instance
+ * @param n_threads Number of threads of each sweep
+ * @param seed The seed for the random number generator
+ */
+SurveyPropagation::SurveyPropagation(
+    const SATInstance &instance,
+    int n_threads,
+    uint seed
+) : seed(seed),
+    n_threads(n_threads),
+    n_vars(instance.n_vars),
+    n_clauses(instance.n_clauses),
+    clause_start(instance.n_clauses + 1, 0),
+    clause_active(instance.n_clauses, true),
+    var_edges(instance.n_vars),
+    value(instance.n_vars, -1),
+    bias(instance.n_vars)
+{
+    // Remove repeated literals; a clause with p v -p is always satisfied
+    vector<int> seen(2 * n_vars, -1);
+    for (int i = 0; i < n_clauses; i++) {
+        clause_start[i] = edge_literal.size();
+
+        bool tautology = false;
+        for (int literal : instance.clauses[i]) {
+            if (seen[literal ^ 1] == i) tautology = true;
+            seen[literal] = i;
+        }
+        if (tautology) {
+            clause_active[i] = false;
+            continue;
+        }
+
+        for (int literal : instance.clauses[i]) {
+            if (seen[literal] != i) continue;
+            seen[literal] = -1;
+
+            var_edges[literal>>1].push_back(edge_literal.size());
+            edge_literal.push_back(literal);
+            edge_clause.push_back(i);
+        }
+
+        // Empty clauses can never be satisfied
+        if ((int) edge_literal.size() == clause_start[i]) clause_active[i] = false;
+    }
+    clause_start[n_clauses] = edge_literal.size();
+
+    survey = vector<double>(edge_literal.size());
+    ratio = vector<double>(edge_literal.size());
+    edge_active = vector<char>(edge_literal.size(), true);
+
+    for (int sign : {0, 1}) {
+        product[sign] = vector<double>(n_vars);
+        n_zeros[sign] = vector<int>(n_vars);
+    }
+}
+
+/**
+ * @brief Alternates convergence of the surveys and decimation while the
+ * surveys are not trivial. The variables left free take the sign they appear
+ * with the most in the remaining clauses
+ *
+ * @return vector<bool> The biased assignment
+ */
+vector<bool> SurveyPropagation::compute_assignment() {
+    srand(seed);
+    for (uint e = 0; e < survey.size(); e++) survey[e] = (double) rand() / RAND_MAX;
+
+    while (true) {
+        converged = converge();
+        if (!converged || !decimate()) break;
+    }
+
+    vector<bool> assignment(n_vars);
+    for (int i = 0; i < n_vars; i++) {
+        if (value[i] != -1) {
+            assignment[i] = value[i];
+            continue;
+        }
+
+        int n_positive = 0, n_negative = 0;
+        for (int e : var_edges[i]) {
+            if (!edge_active[e] || !clause_active[edge_clause[e]]) continue;
+            if (edge_literal[e] & 1) n_negative++;
+            else n_positive++;
+        }
+        assignment[i] = n_positive == n_negative ? rand() & 1 : n_positive > n_negative;
+    }
+
+    return assignment;
+}
+
+/**
+ * @brief Updates every survey from the surveys of the previous sweep until
+ * the largest change is below SP_EPSILON
+ *
+ * @return true if the surveys converged within MAX_SWEEPS
+ */
+bool SurveyPropagation::converge() {
+    for (int sweep = 0; sweep < MAX_SWEEPS; sweep++) {
+        sweeps++;
+        compute_products();
+
+        double max_change = 0;
+
+        #pragma omp parallel for num_threads(n_threads) reduction(max:max_change)
+        for (int i = 0; i < n_clauses; i++) {
+            if (!clause_active[i]) continue;
+
+            // Probability that each variable is forced not to satisfy the
+            // clause by the other clauses it appears in
+            for (int e = clause_start[i]; e < clause_start[i+1]; e++) {
+                if (!edge_active[e]) continue;
+
+                int var = edge_literal[e]>>1;
+                int sign = edge_literal[e] & 1;
+                double same = excluded_product(var, sign, e);
+                double opposite = n_zeros[!sign][var] ? 0 : product[!sign][var];
+
+                double unsat = (1 - opposite) * same;
+                double total = unsat + (1 - same) * opposite + same * opposite;
+                ratio[e] = total > 0 ? unsat / total : 0;
+            }
+
+            for (int e = clause_start[i]; e < clause_start[i+1]; e++) {
+                if (!edge_active[e]) continue;
+
+                double new_survey = 1;
+                for (int f = clause_start[i]; f < clause_start[i+1]; f++)
+                    if (f != e && edge_active[f]) new_survey *= ratio[f];
+
+                max_change = max(max_change, fabs(new_survey - survey[e]));
+                survey[e] = new_survey;
+            }
+        }
+
+        if (max_change < SP_EPSILON) return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Computes, for each free variable and sign, the product of
+ * (1 - survey) over its active edges with that sign
+ */
+void SurveyPropagation::compute_products() {
+    #pragma omp parallel for num_threads(n_threads)
+    for (int i = 0; i < n_vars; i++) {
+        for (int sign : {0, 1}) {
+            product[sign][i] = 1;
+            n_zeros[sign][i] = 0;
+        }
+        if (value[i] != -1) continue;
+
+        for (int e : var_edges[i]) {
+            if (!edge_active[e] || !clause_active[edge_clause[e]]) continue;
+
+            int sign = edge_literal[e] & 1;
+            double factor = 1 - survey[e];
+            if (factor < 1e-16) n_zeros[sign][i]++;
+            else product[sign][i] *= factor;
+        }
+    }
+}
+
+/**
+ * @brief Product of (1 - survey) over the active edges of a variable with the
+ * given sign, leaving out the given edge
+ */
+double SurveyPropagation::excluded_product(int var, int sign, int edge) {
+    double factor = 1 - survey[edge];
+    if (factor < 1e-16) return n_zeros[sign][var] > 1 ? 0 : product[sign][var];
+    return n_zeros[sign][var] ? 0 : product[sign][var] / factor;
+}
+
+/**
+ * @brief Computes the probability that each free variable is forced true or
+ * forced false by the surveys it receives
+ */
+void SurveyPropagation::compute_biases() {
+    compute_products();
+
+    #pragma omp parallel for num_threads(n_threads)
+    for (int i = 0; i < n_vars; i++) {
+        double positive = n_zeros[0][i] ? 0 : product[0][i];
+        double negative = n_zeros[1][i] ? 0 : product[1][i];
+
+        double forced_true = (1 - positive) * negative;
+        double forced_false = (1 - negative) * positive;
+        double total = forced_true + forced_false + positive * negative;
+
+        if (total > 0) bias[i] = make_pair(forced_true / total, forced_false / total);
+        else bias[i] = make_pair(0.0, 0.0);
+    }
+}
+
+/**
+ * @brief Fixes the DECIMATION_FRACTION of the free variables with the largest
+ * difference between being forced true and forced false
+ *
+ * @return false if the surveys are trivial, so no variable was fixed
+ */
+bool SurveyPropagation::decimate() {
+    compute_biases();
+
+    vector<pair<double, int>> candidates;
+    for (int i = 0; i < n_vars; i++) {
+        if (value[i] != -1) continue;
+        candidates.push_back(make_pair(fabs(bias[i].first - bias[i].second), i));
+    }
+    if (candidates.empty()) return false;
+
+    sort(candidates.rbegin(), candidates.rend());
+    if (candidates[0].first < TRIVIAL_BIAS) return false;
+
+    int n_fixed = max(1, (int) (DECIMATION_FRACTION * candidates.size()));
+    for (int k = 0; k < n_fixed && candidates[k].first >= TRIVIAL_BIAS; k++) {
+        int var = candidates[k].second;
+        fix(var, bias[var].first > bias[var].second);
+        n_decimated++;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Fixes a variable: the clauses it satisfies are removed and its
+ * literal is removed from the rest
+ */
+void SurveyPropagation::fix(int var, bool val) {
+    value[var] = val;
+
+    for (int e : var_edges[var]) {
+        int i = edge_clause[e];
+        if (!clause_active[i]) continue;
+
+        if ((edge_literal[e] & 1) != val) {
+            clause_active[i] = false;
+            continue;
+        }
+
+        edge_active[e] = false;
+
+        // A clause with every literal false stays unsatisfied
+        bool empty = true;
+        for (int f = clause_start[i]; f < clause_start[i+1]; f++)
+            if (edge_active[f]) empty = false;
+        if (empty) clause_active[i] = false;
+    }
+}
@@ -0,0 +1,189 @@
+/**
+ * Implementation of a Max-SAT solver based on tabu search
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/TabuSearchSolver.hpp"
+
+using namespace std;
+
+/**
+ * @brief Generates an initial solution for the instance to be solved, using
+ * the given seed
+ *
+ * @param instance The SAT instance
+ * @param min_tenure Lower bound for the tabu tenure
+ * @param max_tenure Upper bound for the tabu tenure
+ * @param seed The seed for the random number generator
+ */
+TabuSearchSolver::TabuSearchSolver(
+    const SATInstance &instance,
+    int min_tenure,
+    int max_tenure,
+    uint seed
+) : MaxSATSolver(instance),
+    seed(seed),
+    min_tenure(min_tenure),
+    max_tenure(max_tenure),
+    tenure(min_tenure),
+    evaluator(instance),
+    tabu_until(instance.n_vars, 0),
+    bucket_of(instance.n_vars, -1),
+    bucket_index(instance.n_vars, -1),
+    visited(1 << HASH_TABLE_BITS, make_pair(0ULL, -1))
+{
+    // Initialize the optimal assignment with random values
+    srand(seed);
+    for (int i = 0; i < instance.n_vars; i++)
+        optimal_assignment.push_back(rand() & 1);
+
+    // The score of a variable is bounded by the number of its occurrences
+    max_score = 0;
+    for (int i = 0; i < instance.n_vars; i++)
+        max_score = max(max_score, (int) evaluator.occurrences[i].size());
+    buckets = vector<vector<int>>(2 * max_score + 1);
+
+    // Random keys to hash the assignments
+    for (int i = 0; i < instance.n_vars; i++) {
+        unsigned long long key = rand();
+        key = (key << 31) ^ rand();
+        var_hash.push_back((key << 31) ^ rand());
+    }
+}
+
+/**
+ * @brief Solves the instance flipping at each move the variable with the best
+ * score that is not tabu, unless flipping it improves the best assignment
+ * found so far (aspiration)
+ */
+void TabuSearchSolver::solve() {
+    compute_upper_bound();
+
+    evaluator.reset(optimal_assignment);
+    optimal_n_satisfied = evaluator.n_satisfied;
+
+    top_bucket = 0;
+    for (int i = 0; i < instance.n_vars; i++) insert_var(i);
+
+    hash = 0;
+    for (int i = 0; i < instance.n_vars; i++)
+        if (evaluator.assignment[i]) hash ^= var_hash[i];
+
+    while (moves < MAX_MOVES) {
+        optimal_found = optimal_n_satisfied >= upper_bound;
+        if (optimal_found) break;
+
+        flip(pick_move());
+        moves++;
+
+        if (evaluator.n_satisfied > optimal_n_satisfied) {
+            optimal_n_satisfied = evaluator.n_satisfied;
+            optimal_assignment = evaluator.assignment;
+        }
+    }
+}
+
+/**
+ * @brief Scans the buckets from the highest score down and returns the first
+ * variable that is not tabu or satisfies the aspiration criterion. Since at
+ * most max_tenure variables are tabu, this is O(1) amortized
+ *
+ * @return int The variable to be flipped
+ */
+int TabuSearchSolver::pick_move() {
+    while (buckets[top_bucket].empty()) top_bucket--;
+
+    for (int b = top_bucket; b >= 0; b--) {
+        vector<int> &bucket = buckets[b];
+        if (bucket.empty()) continue;
+
+        // Aspiration: a move that improves the best assignment is allowed
+        bool aspiration = (
+            evaluator.n_satisfied + b - max_score > optimal_n_satisfied
+        );
+
+        // Start at a random position to break ties
+        int size = bucket.size();
+        int start = rand() % size;
+        for (int k = 0; k < size; k++) {
+            int var = bucket[(start + k) % size];
+            if (aspiration || tabu_until[var] <= moves) return var;
+        }
+    }
+
+    // Every variable is tabu, take the one that leaves the list first
+    int best = 0;
+    for (int i = 1; i < instance.n_vars; i++)
+        if (tabu_until[i] < tabu_until[best]) best = i;
+    return best;
+}
+
+/**
+ * @brief Flips a variable, moving to their new buckets the variables whose
+ * score changed and making the flipped variable tabu
+ *
+ * @param var The variable to be flipped
+ */
+void TabuSearchSolver::flip(int var) {
+    evaluator.flip(var);
+    for (int touched : evaluator.touched) {
+        remove_var(touched);
+        insert_var(touched);
+    }
+    evaluator.clear_touched();
+
+    tabu_until[var] = moves + 1 + (int) tenure;
+    hash ^= var_hash[var];
+    react();
+}
+
+/**
+ * @brief Reactive tenure: if the current assignment was visited recently the
+ * tenure grows, if no repetition is seen for a while it shrinks
+ */
+void TabuSearchSolver::react() {
+    pair<unsigned long long, int> &entry = visited[
+        hash & ((1 << HASH_TABLE_BITS) - 1)
+    ];
+
+    if (entry.first == hash && entry.second >= 0 &&
+        moves - entry.second < 2 * max_tenure) {
+        tenure = min((double) max_tenure, tenure * 1.1 + 1);
+        last_tenure_change = moves;
+    } else if (moves - last_tenure_change > instance.n_vars) {
+        tenure = max((double) min_tenure, tenure * 0.9);
+        last_tenure_change = moves;
+    }
+
+    entry = make_pair(hash, moves);
+}
+
+void TabuSearchSolver::insert_var(int var) {
+    int b = evaluator.score[var] + max_score;
+    bucket_of[var] = b;
+    bucket_index[var] = buckets[b].size();
+    buckets[b].push_back(var);
+    if (b > top_bucket) top_bucket = b;
+}
+
+void TabuSearchSolver::remove_var(int var) {
+    vector<int> &bucket = buckets[bucket_of[var]];
+    int last = bucket.back();
+    bucket[bucket_index[var]] = last;
+    bucket_index[last] = bucket_index[var];
+    bucket.pop_back();
+}
+
+void TabuSearchSolver::print_solution() {
+    cout << "c Tabu Search Solver" << endl;
+    cout << "c MAX_MOVES = " << MAX_MOVES << endl;
+    cout << "c min_tenure = " << min_tenure << endl;
+    cout << "c max_tenure = " << max_tenure << endl;
+    cout << "c seed = " << seed << endl;
+    MaxSATSolver::print_solution();
+}
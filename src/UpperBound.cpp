@@ -0,0 +1,206 @@
+/**
+ * Upper bound on the number of clauses of a Max-SAT instance that can be
+ * satisfied at the same time
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/UpperBound.hpp"
+
+using namespace std;
+
+/**
+ * @brief Prepares the computation of the bound for the given instance
+ *
+ * @param instance The SAT instance
+ */
+UpperBound::UpperBound(const SATInstance &instance)
+    : evaluator(instance),
+      value(instance.n_vars, -1),
+      n_true(instance.n_clauses, 0),
+      n_false(instance.n_clauses, 0),
+      reason(instance.n_vars, -1),
+      used(instance.n_clauses, false)
+{
+    // Tautologies are always satisfied, empty clauses never
+    for (int i = 0; i < instance.n_clauses; i++) {
+        if (evaluator.tautology[i]) {
+            n_true[i] = 1;
+        } else if (evaluator.clauses[i].empty()) {
+            used[i] = true;
+            n_empty++;
+        }
+    }
+}
+
+/**
+ * @brief Computes the bound, the number of clauses minus the number of
+ * disjoint inconsistent subsets found
+ *
+ * @param max_conflicts Conflict budget of the search for cores
+ * @return int The maximum number of clauses that can be satisfied
+ */
+int UpperBound::compute(long long max_conflicts) {
+    n_propagation_subsets = n_core_subsets = 0;
+    count_propagation_subsets();
+
+    // Conflicts get more expensive as the formula grows, so the budget is
+    // scaled down for formulas larger than UPPER_BOUND_CLAUSES, and cores are
+    // not searched at all once it is too small to find any
+    if (evaluator.n_clauses > UPPER_BOUND_CLAUSES)
+        max_conflicts = max_conflicts * UPPER_BOUND_CLAUSES / evaluator.n_clauses;
+    if (max_conflicts >= MIN_UPPER_BOUND_CONFLICTS)
+        count_core_subsets(max_conflicts);
+
+    return evaluator.n_clauses - n_empty - n_propagation_subsets - n_core_subsets;
+}
+
+/**
+ * @brief Repeatedly runs unit propagation from the unit clauses that belong to
+ * no subset and, on each conflict, marks as used the clauses that produced it
+ */
+void UpperBound::count_propagation_subsets() {
+    while (true) {
+        int conflict = -1;
+
+        for (int i = 0; i < evaluator.n_clauses && conflict == -1; i++) {
+            if (used[i] || n_true[i] > 0) continue;
+            if (n_false[i] != (int) evaluator.clauses[i].size() - 1) continue;
+
+            for (int literal : evaluator.clauses[i]) {
+                if (value[literal>>1] != -1) continue;
+                assign(literal>>1, !(literal & 1), i);
+                break;
+            }
+            conflict = propagate(trail.size() - 1);
+        }
+
+        if (conflict != -1) {
+            // Collect the clauses that lead to the conflict
+            vector<int> subset = {conflict};
+            used[conflict] = true;
+            for (uint j = 0; j < subset.size(); j++) {
+                for (int literal : evaluator.clauses[subset[j]]) {
+                    int r = reason[literal>>1];
+                    if (r != -1 && !used[r]) {
+                        used[r] = true;
+                        subset.push_back(r);
+                    }
+                }
+            }
+            n_propagation_subsets++;
+        }
+
+        undo(0);
+        if (conflict == -1) break;
+    }
+}
+
+/**
+ * @brief Looks for unsatisfiable cores among the clauses that belong to no
+ * subset. Each clause is relaxed with a selector assumed false, and the
+ * selectors of every core found are no longer assumed, so the next core is
+ * disjoint from it
+ *
+ * @param max_conflicts Conflict budget of the search
+ */
+void UpperBound::count_core_subsets(long long max_conflicts) {
+    CDCLEngine engine;
+    for (int i = 0; i < evaluator.n_vars; i++) engine.new_var();
+
+    vector<int> assumptions;
+    for (int i = 0; i < evaluator.n_clauses; i++) {
+        if (used[i] || n_true[i] > 0) continue;
+
+        int selector = engine.new_var();
+        vector<int> literals = evaluator.clauses[i];
+        literals.push_back(2 * selector);
+        engine.add_clause(literals);
+        assumptions.push_back(2 * selector + 1);
+    }
+
+    while (engine.conflicts < max_conflicts) {
+        int result = engine.solve(assumptions, max_conflicts - engine.conflicts);
+        if (result != UNSAT_RESULT || engine.core.empty()) break;
+
+        // Smaller cores leave more clauses for the next ones
+        vector<int> core = engine.core;
+        for (int i = 0; i < 3 && engine.conflicts < max_conflicts; i++) {
+            int r = engine.solve(core, max_conflicts - engine.conflicts);
+            if (r != UNSAT_RESULT || engine.core.size() >= core.size()) break;
+            core = engine.core;
+        }
+
+        vector<bool> in_core(engine.n_vars, false);
+        for (int literal : core) in_core[literal>>1] = true;
+
+        vector<int> remaining;
+        for (int literal : assumptions)
+            if (!in_core[literal>>1]) remaining.push_back(literal);
+        assumptions = remaining;
+
+        n_core_subsets++;
+    }
+}
+
+/**
+ * @brief Unit propagation over the unused clauses of the variables assigned
+ * from the given position of the trail
+ *
+ * @param from First position of the trail to propagate
+ * @return int A clause with every literal false, or -1 if there is none
+ */
+int UpperBound::propagate(int from) {
+    for (uint p = from; p < trail.size(); p++) {
+        int var = trail[p];
+        for (auto &occurrence : evaluator.occurrences[var]) {
+            int i = occurrence.first;
+            bool literal_true = (occurrence.second & 1) != value[var];
+            if (literal_true || used[i] || n_true[i] > 0) continue;
+
+            int len = evaluator.clauses[i].size();
+            if (n_false[i] == len) return i;
+            if (n_false[i] != len - 1) continue;
+
+            for (int literal : evaluator.clauses[i]) {
+                if (value[literal>>1] != -1) continue;
+                assign(literal>>1, !(literal & 1), i);
+                break;
+            }
+        }
+    }
+
+    return -1;
+}
+
+void UpperBound::assign(int var, bool val, int from) {
+    value[var] = val;
+    reason[var] = from;
+    trail.push_back(var);
+
+    for (auto &occurrence : evaluator.occurrences[var]) {
+        if ((occurrence.second & 1) != val) n_true[occurrence.first]++;
+        else n_false[occurrence.first]++;
+    }
+}
+
+/**
+ * @brief Unassigns the variables of the trail back to the given size
+ */
+void UpperBound::undo(int trail_size) {
+    while ((int) trail.size() > trail_size) {
+        int var = trail.back();
+        trail.pop_back();
+
+        for (auto &occurrence : evaluator.occurrences[var]) {
+            if ((occurrence.second & 1) != value[var]) n_true[occurrence.first]--;
+            else n_false[occurrence.first]--;
+        }
+
+        value[var] = -1;
+        reason[var] = -1;
+    }
+}
@@ -0,0 +1,131 @@
+/**
+ * Implementation of a Max-SAT solver based on variable neighborhood search
+ * (VNS)
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "../include/SATInstance.hpp"
+#include "../include/VNSSolver.hpp"
+
+using namespace std;
+
+/**
+ * @brief Generates an initial solution for the instance to be solved, using
+ * the given seed
+ *
+ * @param instance The SAT instance
+ * @param k_min Number of random flips of the first neighborhood
+ * @param k_max Number of random flips of the last neighborhood
+ * @param seed The seed for the random number generator
+ */
+VNSSolver::VNSSolver(
+    const SATInstance &instance,
+    int k_min,
+    int k_max,
+    uint seed
+) : MaxSATSolver(instance),
+    seed(seed),
+    k_min(k_min),
+    k_max(k_max),
+    evaluator(instance)
+{
+    // Initialize the optimal assignment with random values
+    srand(seed);
+    for (int i = 0; i < instance.n_vars; i++)
+        optimal_assignment.push_back(rand() & 1);
+}
+
+/**
+ * @brief Solves the instance with variable neighborhood search: the current
+ * solution is shaken with k random flips and then improved with local search;
+ * if the result is not worse it becomes the current solution and k goes back
+ * to k_min, otherwise the flips are undone and k grows
+ */
+void VNSSolver::solve() {
+    compute_upper_bound();
+
+    evaluator.reset(optimal_assignment);
+    descend();
+    flip_log.clear();
+
+    optimal_n_satisfied = evaluator.n_satisfied;
+    optimal_assignment = evaluator.assignment;
+
+    int k = k_min;
+    int current_n_satisfied = evaluator.n_satisfied;
+    while (shakes < MAX_SHAKES) {
+        optimal_found = optimal_n_satisfied >= upper_bound;
+        if (optimal_found) break;
+
+        shake(k);
+        descend();
+        shakes++;
+
+        if (evaluator.n_satisfied >= current_n_satisfied) {
+            // Move to the new solution
+            current_n_satisfied = evaluator.n_satisfied;
+            flip_log.clear();
+            k = k_min;
+
+            if (current_n_satisfied > optimal_n_satisfied) {
+                optimal_n_satisfied = current_n_satisfied;
+                optimal_assignment = evaluator.assignment;
+            }
+        } else {
+            // Go back to the current solution and try a larger neighborhood
+            undo();
+            k = k < k_max ? k + 1 : k_min;
+        }
+    }
+}
+
+/**
+ * @brief Flips k random variables
+ *
+ * @param k The number of variables to flip
+ */
+void VNSSolver::shake(int k) {
+    for (int i = 0; i < k; i++) flip(rand() % instance.n_vars);
+}
+
+/**
+ * @brief Flips variables with positive score until there is none left
+ */
+void VNSSolver::descend() {
+    evaluator.update_good_vars();
+    while (evaluator.good_vars.size()) {
+        int var = evaluator.good_vars[rand() % evaluator.good_vars.size()];
+        flip(var);
+    }
+}
+
+/**
+ * @brief Undoes, in reverse order, every flip since the current solution was
+ * accepted
+ */
+void VNSSolver::undo() {
+    for (int i = flip_log.size() - 1; i >= 0; i--) {
+        evaluator.flip(flip_log[i]);
+    }
+    evaluator.update_good_vars();
+    flip_log.clear();
+}
+
+void VNSSolver::flip(int var) {
+    evaluator.flip(var);
+    evaluator.update_good_vars();
+    flip_log.push_back(var);
+}
+
+void VNSSolver::print_solution() {
+    cout << "c Variable Neighborhood Search Solver" << endl;
+    cout << "c MAX_SHAKES = " << MAX_SHAKES << endl;
+    cout << "c k_min = " << k_min << endl;
+    cout << "c k_max = " << k_max << endl;
+    cout << "c seed = " << seed << endl;
+    MaxSATSolver::print_solution();
+}
@@ -0,0 +1,150 @@
+/**
+ * Work-stealing scheduler for independent tasks of uneven length
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <omp.h>
+#include <vector>
+
+#include "../include/WorkStealingPool.hpp"
+
+using namespace std;
+
+/**
+ * @param n_workers Number of threads that run the tasks
+ */
+WorkStealingPool::WorkStealingPool(int n_workers) : n_workers(n_workers) {
+    resize();
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    for (TaskQueue &queue : queues) omp_destroy_lock(&queue.lock);
+}
+
+/**
+ * @brief Runs tasks 0 to n_tasks - 1 and waits for all of them. The worker
+ * that runs a task is below n_workers, so it can index per-worker state
+ *
+ * @param n_tasks Number of tasks
+ * @param task Function called with the task and the worker that runs it
+ */
+void WorkStealingPool::run(int n_tasks, const function<void(int task, int worker)> &task) {
+    int n = max(1, min(n_workers, n_tasks));
+    resize();
+    for (int w = 0; w < n; w++) {
+        queues[w].tasks.clear();
+        for (int t = (long long) w * n_tasks / n; t < (long long) (w + 1) * n_tasks / n; t++)
+            queues[w].tasks.push_back(t);
+    }
+
+    // If the team gets fewer threads, the tasks of the missing workers are
+    // stolen by the others
+    #pragma omp parallel num_threads(n)
+    {
+        int worker = omp_get_thread_num();
+        int t;
+        while (pop(worker, t) || steal(worker, n, t)) {
+            start_task(worker, t);
+            task(t, worker);
+        }
+    }
+
+    n_batches++;
+    n_tasks_run += n_tasks;
+}
+
+/**
+ * @brief Draws a number from the generator of a worker, xorshift64*. Outside
+ * a batch, worker 0 can be used by the calling thread
+ *
+ * @param worker The worker
+ * @return uint32_t A uniform random number
+ */
+uint32_t WorkStealingPool::next_random(int worker) {
+    uint64_t &state = queues[worker].random_state;
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (state * 2685821657736338717ULL) >> 32;
+}
+
+/**
+ * @brief Gives a deque to each worker if n_workers changed since the last
+ * batch. The locks are destroyed before the deques move and initialized again
+ * in their new place
+ */
+void WorkStealingPool::resize() {
+    int size = max(n_workers, 1);
+    if ((int) queues.size() == size) return;
+
+    for (TaskQueue &queue : queues) omp_destroy_lock(&queue.lock);
+    queues.resize(size);
+    for (TaskQueue &queue : queues) omp_init_lock(&queue.lock);
+}
+
+/**
+ * @brief Restarts the generator of a worker for a task, mixing the seed, the
+ * batch and the task (splitmix64 finalizer)
+ *
+ * @param worker The worker
+ * @param task The task
+ */
+void WorkStealingPool::start_task(int worker, int task) {
+    uint64_t z = seed * 2654435761ULL + ((uint64_t) n_batches << 32 | (uint32_t) task);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    queues[worker].random_state = z ? z : 1;
+}
+
+/**
+ * @brief Takes the last task of the deque of a worker
+ *
+ * @param worker The worker
+ * @param task [out] The task
+ * @return bool Whether there was a task
+ */
+bool WorkStealingPool::pop(int worker, int &task) {
+    TaskQueue &queue = queues[worker];
+    omp_set_lock(&queue.lock);
+    bool found = !queue.tasks.empty();
+    if (found) {
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+    }
+    omp_unset_lock(&queue.lock);
+    return found;
+}
+
+/**
+ * @brief Takes the first task of the deque of another worker of the batch,
+ * visiting them from the next one on
+ *
+ * @param worker The worker that steals
+ * @param n_active Number of workers of the batch
+ * @param task [out] The task
+ * @return bool Whether a task was found in any deque
+ */
+bool WorkStealingPool::steal(int worker, int n_active, int &task) {
+    for (int k = 1; k < n_active; k++) {
+        TaskQueue &queue = queues[(worker + k) % n_active];
+        omp_set_lock(&queue.lock);
+        bool found = !queue.tasks.empty();
+        if (found) {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+        omp_unset_lock(&queue.lock);
+
+        if (found) {
+            #pragma omp atomic
+            n_steals++;
+            return true;
+        }
+    }
+    return false;
+}
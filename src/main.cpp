@@ -10,14 +10,25 @@
 #include <chrono>
 
 #include "../include/BruteForceSolver.hpp"
+#include "../include/BranchAndBoundSolver.hpp"
+#include "../include/CoreGuidedSolver.hpp"
 #include "../include/LocalSearchSolver.hpp"
 #include "../include/GLSSolver.hpp"
 #include "../include/SimulatedAnnealingSolver.hpp"
+#include "../include/ParallelTemperingSolver.hpp"
+#include "../include/IslandModelSolver.hpp"
 #include "../include/GeneticAlgorithmSolver.hpp"
 #include "../include/MemeticAlgorithmSolver.hpp"
 #include "../include/ACOSolver.hpp"
 #include "../include/SATInstance.hpp"
 #include "../include/SolutionTreeSolver.hpp"
+#include "../include/ClauseWeightingSolver.hpp"
+#include "../include/TabuSearchSolver.hpp"
+#include "../include/VNSSolver.hpp"
+#include "../include/MultilevelSolver.hpp"
+#include "../include/PathRelinkingSolver.hpp"
+#include "../include/Backbone.hpp"
+#include "../include/SurveyPropagation.hpp"
 
 using namespace std;
 
@@ -46,6 +57,20 @@ int main(int argc, char *argv[]) {
     // bf_solver.print_solution();
     // bf_solver.verify_solution();
 
+    // ========== BRANCH AND BOUND ==========
+    // BranchAndBoundSolver bb_solver(instance);
+    // double bb_solver_t = measure_time([&] { bb_solver.solve(); });
+    // cout << "c time = " << bb_solver_t << "s" << endl;
+    // bb_solver.print_solution();
+    // bb_solver.verify_solution();
+
+    // ========== CORE GUIDED ==========
+    // CoreGuidedSolver cg_solver(instance);
+    // double cg_solver_t = measure_time([&] { cg_solver.solve(); });
+    // cout << "c time = " << cg_solver_t << "s" << endl;
+    // cg_solver.print_solution();
+    // cg_solver.verify_solution();
+
     // ========== LOCAL SEARCH ==========
     LocalSearchSolver ls_solver(instance);
     double ls_solver_t = measure_time([&] { ls_solver.solve(); });
@@ -71,11 +96,20 @@ int main(int argc, char *argv[]) {
     // 4sat_300_2500_35 
     // temp auto, cool fact 0.01, log cool, 2500, 0.029113s
     // SimulatedAnnealingSolver sa_solver(instance, 0.01);
+    // sa_solver.schedule = GEOMETRIC_SCHEDULE;
     // double sa_solver_t = measure_time([&] { sa_solver.solve(); });
     // cout << "c time = " << sa_solver_t << "s" << endl;
     // sa_solver.print_solution();
     // sa_solver.verify_solution();
 
+    // ========== PARALLEL TEMPERING ==========
+    // Param: n_replicas, min_temperature, max_temperature
+    // ParallelTemperingSolver pt_solver(instance, 6, 0.2, 1.5);
+    // double pt_solver_t = measure_time([&] { pt_solver.solve(); });
+    // cout << "c time = " << pt_solver_t << "s" << endl;
+    // pt_solver.print_solution();
+    // pt_solver.verify_solution();
+
     // ========== GENETIC ALGORITHM ==========
     /* Param: population_size, tournament_size, 
      *      mutation_probability, mutation_percent, elite_rate
@@ -90,6 +124,16 @@ int main(int argc, char *argv[]) {
     // ga_solver.print_solution();
     // ga_solver.verify_solution();
 
+    // ========== ISLAND MODEL ==========
+    /* Param: n_islands, population_size, tournament_size,
+     *      mutation_probability, mutation_percent, elite_rate
+     */
+    // IslandModelSolver im_solver(instance, 6, 100, 5, 60, 1, 5);
+    // double im_solver_t = measure_time([&] { im_solver.solve(); });
+    // cout << "c time = " << im_solver_t << "s" << endl;
+    // im_solver.print_solution();
+    // im_solver.verify_solution();
+
     // ========== ACO ==========
     /* Param: n_ants, alpha, beta, rho, q0, tau0,
      *
@@ -107,6 +151,76 @@ int main(int argc, char *argv[]) {
     // ma_solver.print_solution();
     // ma_solver.verify_solution();
 
+    // ========== CLAUSE WEIGHTING ==========
+    // Param: bms_samples, smooth_probability, max_weight
+    // ClauseWeightingSolver cw_solver(instance, 15, 0.01, 300);
+    // double cw_solver_t = measure_time([&] { cw_solver.solve(); });
+    // cout << "c time = " << cw_solver_t << "s" << endl;
+    // cw_solver.print_solution();
+    // cw_solver.verify_solution();
+
+    // ========== TABU SEARCH ==========
+    // Param: min_tenure, max_tenure
+    // TabuSearchSolver ts_solver(instance, 10, 200);
+    // double ts_solver_t = measure_time([&] { ts_solver.solve(); });
+    // cout << "c time = " << ts_solver_t << "s" << endl;
+    // ts_solver.print_solution();
+    // ts_solver.verify_solution();
+
+    // ========== VARIABLE NEIGHBORHOOD SEARCH ==========
+    // Param: k_min, k_max
+    // VNSSolver vns_solver(instance, 1, 10);
+    // double vns_solver_t = measure_time([&] { vns_solver.solve(); });
+    // cout << "c time = " << vns_solver_t << "s" << endl;
+    // vns_solver.print_solution();
+    // vns_solver.verify_solution();
+
+    // ========== MULTILEVEL ==========
+    // Param: coarsest_vars, flips_per_var
+    // MultilevelSolver ml_solver(instance, 100, 200);
+    // double ml_solver_t = measure_time([&] { ml_solver.solve(); });
+    // cout << "c time = " << ml_solver_t << "s" << endl;
+    // ml_solver.print_solution();
+    // ml_solver.verify_solution();
+
+    // ========== PATH RELINKING ==========
+    // Param: archive_size, min_distance
+    // PathRelinkingSolver pr_solver(instance, 10, instance.n_vars / 20);
+    // double pr_solver_t = measure_time([&] { pr_solver.solve(); });
+    // cout << "c time = " << pr_solver_t << "s" << endl;
+    // pr_solver.print_solution();
+    // pr_solver.verify_solution();
+
+    // ========== BACKBONE FIXING ==========
+    // Fixes the variables on which the path relinking archive agrees and
+    // searches over the rest with clause weighting
+    // Param: agreement
+    // Backbone backbone(instance);
+    // backbone.estimate(pr_solver.archive.solutions, 0.9);
+    // SATInstance reduced = backbone.reduce();
+    // ClauseWeightingSolver bb_solver(reduced, 15, 0.01, 300);
+    // bb_solver.set_upper_bound(pr_solver.upper_bound - backbone.n_satisfied);
+    // double bb_solver_t = measure_time([&] { bb_solver.solve(); });
+    // cout << "c time = " << bb_solver_t << "s" << endl;
+    // cout << "c fixed = " << backbone.n_fixed << endl;
+    // pr_solver.set_initial_assignment(backbone.extend(bb_solver.optimal_assignment));
+    // pr_solver.print_solution();
+    // pr_solver.verify_solution();
+
+    // ========== SURVEY PROPAGATION INITIALIZER ==========
+    // Param: n_threads
+    // Any solver can start from the biased assignment instead of a random one
+    // SurveyPropagation sp(instance, 6);
+    // vector<bool> sp_assignment;
+    // double sp_t = measure_time([&] { sp_assignment = sp.compute_assignment(); });
+    // cout << "c survey propagation time = " << sp_t << "s" << endl;
+    // ClauseWeightingSolver sp_cw_solver(instance, 15, 0.01, 300);
+    // sp_cw_solver.set_initial_assignment(sp_assignment);
+    // double sp_cw_solver_t = measure_time([&] { sp_cw_solver.solve(); });
+    // cout << "c time = " << sp_cw_solver_t << "s" << endl;
+    // sp_cw_solver.print_solution();
+    // sp_cw_solver.verify_solution();
+
     // ========== SOLUTION TREE ==========
     int branching_factor = stoi(argv[2]);
     int max_depth = stoi(argv[3]);
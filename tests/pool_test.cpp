@@ -0,0 +1,64 @@
+/**
+ * Regression test of the work-stealing pool: every task of a batch runs once
+ * on a worker below n_workers, also when the batch has fewer tasks than
+ * workers or none, and when n_workers changes between batches
+ *
+ * Copyright (C) 2023 Christopher Gómez, Ka Fung
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "../include/WorkStealingPool.hpp"
+
+using namespace std;
+
+/**
+ * @brief Runs a batch and checks how many times each task ran
+ *
+ * @param pool The pool
+ * @param n_tasks Number of tasks
+ * @return bool Whether the batch was correct
+ */
+bool check_batch(WorkStealingPool &pool, int n_tasks) {
+    vector<int> runs(n_tasks, 0);
+    int bad_workers = 0;
+
+    pool.run(n_tasks, [&](int task, int worker) {
+        #pragma omp atomic
+        runs[task]++;
+        if (worker < 0 || worker >= pool.n_workers) {
+            #pragma omp atomic
+            bad_workers++;
+        }
+    });
+
+    bool ok = bad_workers == 0;
+    for (int r : runs) ok &= r == 1;
+    if (!ok) cout << "FAIL n_workers = " << pool.n_workers << ", n_tasks = " << n_tasks << endl;
+    return ok;
+}
+
+int main() {
+    bool ok = true;
+
+    for (int n_workers : {1, 2, 6, 8}) {
+        WorkStealingPool pool(n_workers);
+        // Batches smaller than the team come before and after full ones, so
+        // idle deques of a previous batch are visited again
+        for (int round = 0; round < 20; round++)
+            for (int n_tasks : {0, 1, n_workers - 1, n_workers, 3 * n_workers + 1, 2})
+                ok &= check_batch(pool, n_tasks);
+    }
+
+    // The deques are sized again when n_workers changes
+    WorkStealingPool pool(2);
+    for (int n_workers : {2, 6, 1, 8, 3}) {
+        pool.n_workers = n_workers;
+        for (int n_tasks : {0, 1, n_workers + 5})
+            ok &= check_batch(pool, n_tasks);
+    }
+
+    cout << (ok ? "OK" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}